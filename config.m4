@@ -89,10 +89,12 @@ if test "$PHP_PDO_SNOWFLAKE" != "no"; then
 
   PHP_NEW_EXTENSION(
     pdo_snowflake,
-    pdo_snowflake.c snowflake_driver.c snowflake_stmt.c snowflake_paramstore.c snowflake_arraylist.c snowflake_treemap.c snowflake_rbtree.c,
+    pdo_snowflake.c snowflake_driver.c snowflake_stmt.c snowflake_paramstore.c snowflake_arraylist.c snowflake_treemap.c snowflake_rbtree.c snowflake_temporal.c snowflake_timezone.c snowflake_hex.c snowflake_memory.c,
     $ext_shared,
     ,
     "-DZEND_ENABLE_STATIC_TSRMLS_CACHE=1")
+  PHP_ADD_EXTENSION_DEP(pdo_snowflake, pdo)
+  PHP_ADD_EXTENSION_DEP(pdo_snowflake, json)
 fi
 
 if test "$PHP_COVERAGE" = "yes"; then
@@ -12,6 +12,7 @@
 #include "pdo/php_pdo_driver.h"
 #include "php_pdo_snowflake.h"
 #include "php_pdo_snowflake_int.h"
+#include "snowflake_hex.h"
 
 ZEND_DECLARE_MODULE_GLOBALS(pdo_snowflake)
 
@@ -61,6 +62,8 @@ static PHP_MINIT_FUNCTION(pdo_snowflake) {
         .dealloc_fn = _pdo_snowflake_user_dealloc
     };
 
+    /* the client allocates from its own threads, so the memory is not
+     * from the Zend memory manager */
     snowflake_global_init(logdir, log_from_str_to_level(loglevel), &php_hooks);
     snowflake_global_set_attribute(SF_GLOBAL_CA_BUNDLE_FILE, cacert);
     sf_bool debug_bool =
@@ -73,6 +76,53 @@ static PHP_MINIT_FUNCTION(pdo_snowflake) {
     REGISTER_PDO_CLASS_CONST_LONG(
       "SNOWFLAKE_ATTR_SSL_VERIFY_CERTIFICATE_REVOCATION_STATUS",
       (zend_long) PDO_SNOWFLAKE_ATTR_SSL_VERIFY_CERTIFICATE_REVOCATION_STATUS);
+    REGISTER_PDO_CLASS_CONST_LONG("SNOWFLAKE_ATTR_DESCRIBE_ONLY",
+                                  (zend_long) PDO_SNOWFLAKE_ATTR_DESCRIBE_ONLY);
+    REGISTER_PDO_CLASS_CONST_LONG("SNOWFLAKE_ATTR_FETCH_TEMPORAL",
+                                  (zend_long) PDO_SNOWFLAKE_ATTR_FETCH_TEMPORAL);
+    REGISTER_PDO_CLASS_CONST_LONG(
+      "SNOWFLAKE_FETCH_TEMPORAL_STRING",
+      (zend_long) PDO_SNOWFLAKE_FETCH_TEMPORAL_STRING);
+    REGISTER_PDO_CLASS_CONST_LONG(
+      "SNOWFLAKE_FETCH_TEMPORAL_EPOCH_SECONDS",
+      (zend_long) PDO_SNOWFLAKE_FETCH_TEMPORAL_EPOCH_SECONDS);
+    REGISTER_PDO_CLASS_CONST_LONG(
+      "SNOWFLAKE_FETCH_TEMPORAL_EPOCH_NANOSECONDS",
+      (zend_long) PDO_SNOWFLAKE_FETCH_TEMPORAL_EPOCH_NANOSECONDS);
+    REGISTER_PDO_CLASS_CONST_LONG(
+      "SNOWFLAKE_FETCH_TEMPORAL_DATETIME",
+      (zend_long) PDO_SNOWFLAKE_FETCH_TEMPORAL_DATETIME);
+    REGISTER_PDO_CLASS_CONST_LONG("SNOWFLAKE_ATTR_FETCH_NUMBER",
+                                  (zend_long) PDO_SNOWFLAKE_ATTR_FETCH_NUMBER);
+    REGISTER_PDO_CLASS_CONST_LONG(
+      "SNOWFLAKE_FETCH_NUMBER_STRING",
+      (zend_long) PDO_SNOWFLAKE_FETCH_NUMBER_STRING);
+    REGISTER_PDO_CLASS_CONST_LONG(
+      "SNOWFLAKE_FETCH_NUMBER_NATIVE",
+      (zend_long) PDO_SNOWFLAKE_FETCH_NUMBER_NATIVE);
+    REGISTER_PDO_CLASS_CONST_LONG("SNOWFLAKE_ATTR_FETCH_VARIANT",
+                                  (zend_long) PDO_SNOWFLAKE_ATTR_FETCH_VARIANT);
+    REGISTER_PDO_CLASS_CONST_LONG(
+      "SNOWFLAKE_FETCH_VARIANT_STRING",
+      (zend_long) PDO_SNOWFLAKE_FETCH_VARIANT_STRING);
+    REGISTER_PDO_CLASS_CONST_LONG(
+      "SNOWFLAKE_FETCH_VARIANT_ARRAY",
+      (zend_long) PDO_SNOWFLAKE_FETCH_VARIANT_ARRAY);
+    REGISTER_PDO_CLASS_CONST_LONG(
+      "SNOWFLAKE_FETCH_VARIANT_OBJECT",
+      (zend_long) PDO_SNOWFLAKE_FETCH_VARIANT_OBJECT);
+    REGISTER_PDO_CLASS_CONST_LONG("SNOWFLAKE_ATTR_FETCH_BINARY",
+                                  (zend_long) PDO_SNOWFLAKE_ATTR_FETCH_BINARY);
+    REGISTER_PDO_CLASS_CONST_LONG(
+      "SNOWFLAKE_FETCH_BINARY_HEX",
+      (zend_long) PDO_SNOWFLAKE_FETCH_BINARY_HEX);
+    REGISTER_PDO_CLASS_CONST_LONG(
+      "SNOWFLAKE_FETCH_BINARY_RAW",
+      (zend_long) PDO_SNOWFLAKE_FETCH_BINARY_RAW);
+    REGISTER_PDO_CLASS_CONST_LONG("SNOWFLAKE_ATTR_INTERN_STRINGS",
+                                  (zend_long) PDO_SNOWFLAKE_ATTR_INTERN_STRINGS);
+
+    pdo_sf_hex_init();
 
     return php_pdo_register_driver(&pdo_snowflake_driver);
 }
@@ -92,10 +142,18 @@ static PHP_MSHUTDOWN_FUNCTION(pdo_snowflake) {
 /* {{{ PHP_MINFO_FUNCTION
  */
 static PHP_MINFO_FUNCTION(pdo_snowflake) {
+    char buf[32];
+
     php_info_print_table_start();
     php_info_print_table_header(2, "PDO Driver for Snowflake", "enabled");
     /* TODO: get Snowflake Driver version, etc*/
     php_info_print_table_row(2, "Version", PDO_SNOWFLAKE_VERSION);
+    snprintf(buf, sizeof(buf), ZEND_ULONG_FMT,
+             (zend_ulong) pdo_sf_memory_usage());
+    php_info_print_table_row(2, "Client memory usage", buf);
+    snprintf(buf, sizeof(buf), ZEND_ULONG_FMT,
+             (zend_ulong) pdo_sf_memory_peak_usage());
+    php_info_print_table_row(2, "Client memory peak usage", buf);
 
     php_info_print_table_end();
 
@@ -114,6 +172,13 @@ static PHP_GINIT_FUNCTION(pdo_snowflake) {
     pdo_snowflake_globals->loglevel = "DEBUG";
     pdo_snowflake_globals->cacert = NULL;
     pdo_snowflake_globals->debug = NULL;
+    pdo_snowflake_globals->timezones = NULL;
+}
+/* }}} */
+
+/* {{{ PHP_GSHUTDOWN_FUNCTION */
+static PHP_GSHUTDOWN_FUNCTION(pdo_snowflake) {
+    pdo_sf_timezone_cache_destroy(&pdo_snowflake_globals->timezones);
 }
 /* }}} */
 
@@ -126,6 +191,8 @@ const zend_function_entry pdo_snowflake_functions[] = {
 /* {{{ pdo_snowflake_deps[] */
 static const zend_module_dep pdo_snowflake_deps[] = {
   ZEND_MOD_REQUIRED("pdo")
+  ZEND_MOD_REQUIRED("date")
+  ZEND_MOD_REQUIRED("json")
   ZEND_MOD_END
 };
 /* }}} */
@@ -144,7 +211,7 @@ zend_module_entry pdo_snowflake_module_entry = {
   PDO_SNOWFLAKE_VERSION,
   PHP_MODULE_GLOBALS(pdo_snowflake),
   PHP_GINIT(pdo_snowflake),
-  NULL,
+  PHP_GSHUTDOWN(pdo_snowflake),
   NULL,
   STANDARD_MODULE_PROPERTIES_EX
 };
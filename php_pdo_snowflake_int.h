@@ -6,6 +6,8 @@
 #include <snowflake/client.h>
 #include <snowflake/logger.h>
 #include "snowflake_paramstore.h"
+#include "snowflake_timezone.h"
+#include "snowflake_memory.h"
 
 /**
  * PHP PDO Snowflake Driver name
@@ -26,6 +28,7 @@ ZEND_BEGIN_MODULE_GLOBALS(pdo_snowflake)
     char *logdir; /* log directory */
     char *loglevel; /* log level */
     char *debug; /* debug flag. This dumps all logs on screen */
+    HashTable *timezones; /* time zone offset rules by name */
 ZEND_END_MODULE_GLOBALS(pdo_snowflake)
 
 ZEND_EXTERN_MODULE_GLOBALS(pdo_snowflake)
@@ -44,8 +47,22 @@ typedef struct {
     size_t size;
 } pdo_snowflake_string;
 
+/**
+ * Options of a statement. The connection keeps the defaults of the
+ * statements it prepares.
+ */
+typedef struct {
+    zend_long fetch_temporal; /* fetch type of DATE, TIME and TIMESTAMP */
+    zend_long fetch_number; /* fetch type of NUMBER */
+    zend_long fetch_variant; /* fetch type of VARIANT, OBJECT and ARRAY */
+    zend_long fetch_binary; /* fetch type of BINARY */
+    zend_long intern_strings; /* max distinct strings shared per column */
+} pdo_snowflake_stmt_options;
+
 typedef struct {
     SF_CONNECT *server;
+
+    pdo_snowflake_stmt_options options; /* defaults of the statements */
 } pdo_snowflake_db_handle;
 
 typedef struct {
@@ -54,6 +71,14 @@ typedef struct {
 
     void *bound_params;
     pdo_snowflake_string *bound_results;
+    zend_uchar *column_formats; /* formatter of each column to a string */
+    HashTable **interned; /* strings shared by the cells of each column */
+
+    zend_bool describe_only; /* describe the query instead of running it */
+    pdo_snowflake_stmt_options options;
+    const PDO_SF_TIMEZONE *timezone; /* session time zone for TIMESTAMP_LTZ */
+    zend_bool timezone_loaded; /* timezone is looked up for the result */
+    zend_long row_position; /* 1-based number of the current row, 0 if none */
 } pdo_snowflake_stmt;
 
 extern pdo_driver_t pdo_snowflake_driver;
@@ -63,18 +88,65 @@ extern int
 _pdo_snowflake_error(pdo_dbh_t *dbh, pdo_stmt_t *stmt, const char *file,
                      int line);
 
-extern void *_pdo_snowflake_user_realloc(void* org_ptr, size_t new_size);
-extern void *_pdo_snowflake_user_calloc(size_t nitems, size_t size);
-extern void *_pdo_snowflake_user_malloc(size_t size);
-extern void _pdo_snowflake_user_dealloc(void* ptr);
-
 #define pdo_snowflake_error(d) _pdo_snowflake_error(d, NULL, __FILE__, __LINE__)
 #define pdo_snowflake_error_stmt(s) _pdo_snowflake_error(s->dbh, s, __FILE__, __LINE__)
 
 enum {
     PDO_SNOWFLAKE_ATTR_SSL_CAPATH = PDO_ATTR_DRIVER_SPECIFIC,
     PDO_SNOWFLAKE_ATTR_SSL_VERSION,
-    PDO_SNOWFLAKE_ATTR_SSL_VERIFY_CERTIFICATE_REVOCATION_STATUS
+    PDO_SNOWFLAKE_ATTR_SSL_VERIFY_CERTIFICATE_REVOCATION_STATUS,
+    PDO_SNOWFLAKE_ATTR_DESCRIBE_ONLY,
+    PDO_SNOWFLAKE_ATTR_FETCH_TEMPORAL,
+    PDO_SNOWFLAKE_ATTR_FETCH_NUMBER,
+    PDO_SNOWFLAKE_ATTR_FETCH_VARIANT,
+    PDO_SNOWFLAKE_ATTR_FETCH_BINARY,
+    PDO_SNOWFLAKE_ATTR_INTERN_STRINGS
+};
+
+/**
+ * Values of PDO_SNOWFLAKE_ATTR_FETCH_TEMPORAL
+ */
+enum {
+    PDO_SNOWFLAKE_FETCH_TEMPORAL_STRING = 0,
+    PDO_SNOWFLAKE_FETCH_TEMPORAL_EPOCH_SECONDS,
+    PDO_SNOWFLAKE_FETCH_TEMPORAL_EPOCH_NANOSECONDS,
+    PDO_SNOWFLAKE_FETCH_TEMPORAL_DATETIME
+};
+
+/**
+ * Values of PDO_SNOWFLAKE_ATTR_FETCH_NUMBER
+ */
+enum {
+    PDO_SNOWFLAKE_FETCH_NUMBER_STRING = 0,
+    PDO_SNOWFLAKE_FETCH_NUMBER_NATIVE
+};
+
+/**
+ * Values of PDO_SNOWFLAKE_ATTR_FETCH_VARIANT
+ */
+enum {
+    PDO_SNOWFLAKE_FETCH_VARIANT_STRING = 0,
+    PDO_SNOWFLAKE_FETCH_VARIANT_ARRAY,
+    PDO_SNOWFLAKE_FETCH_VARIANT_OBJECT
+};
+
+/**
+ * Values of PDO_SNOWFLAKE_ATTR_FETCH_BINARY
+ */
+enum {
+    PDO_SNOWFLAKE_FETCH_BINARY_HEX = 0,
+    PDO_SNOWFLAKE_FETCH_BINARY_RAW
+};
+
+/**
+ * Formatter of a column to a string, decided by the first value of
+ * the result.
+ */
+enum {
+    PDO_SNOWFLAKE_FORMAT_UNKNOWN = 0,
+    PDO_SNOWFLAKE_FORMAT_CLIENT, /* snowflake_column_as_str */
+    PDO_SNOWFLAKE_FORMAT_DRIVER, /* pdo_sf_temporal_to_str */
+    PDO_SNOWFLAKE_FORMAT_RAW     /* snowflake_column_as_const_str */
 };
 
 #define PDO_SNOWFLAKE_CONN_ATTR_HOST_IDX 0
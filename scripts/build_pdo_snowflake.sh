@@ -56,6 +56,10 @@ if [[ "$PLATFORM" == "linux" ]]; then
         .libs/snowflake_arraylist.o \
         .libs/snowflake_treemap.o \
         .libs/snowflake_rbtree.o \
+        .libs/snowflake_temporal.o \
+        .libs/snowflake_timezone.o \
+        .libs/snowflake_hex.o \
+        .libs/snowflake_memory.o \
         libsnowflakeclient/lib/linux/libsnowflakeclient.a \
         libsnowflakeclient/deps-build/linux/openssl/lib/libcrypto.a \
         libsnowflakeclient/deps-build/linux/openssl/lib/libssl.a \
@@ -88,6 +92,10 @@ elif [[ "$PLATFORM" == "darwin" ]]; then
         .libs/snowflake_arraylist.o \
         .libs/snowflake_treemap.o \
         .libs/snowflake_rbtree.o \
+        .libs/snowflake_temporal.o \
+        .libs/snowflake_timezone.o \
+        .libs/snowflake_hex.o \
+        .libs/snowflake_memory.o \
         .libs/pdo_snowflake.o \
         .libs/snowflake_driver.o \
         .libs/snowflake_stmt.o \
@@ -9,29 +9,78 @@
 #include "php_pdo_snowflake_int.h"
 #include "Zend/zend_exceptions.h"
 
-void *_pdo_snowflake_user_realloc(void* org_ptr, size_t new_size) /* {{{ */
-{
-    return erealloc(org_ptr, new_size);
-}
-/* }}} */
+/**
+ * Attribute of a statement option. The value is valid from 0 to max.
+ */
+typedef struct {
+    zend_long attr;
+    size_t offset; /* of the field in pdo_snowflake_stmt_options */
+    zend_long max;
+    const char *error;
+} pdo_snowflake_stmt_option;
+
+#define PDO_SF_STMT_OPTION(name, field, max) \
+    {PDO_SNOWFLAKE_ATTR_##name, \
+     offsetof(pdo_snowflake_stmt_options, field), (max), \
+     "Invalid value of SNOWFLAKE_ATTR_" #name}
+
+static const pdo_snowflake_stmt_option stmt_options[] = {
+    PDO_SF_STMT_OPTION(FETCH_TEMPORAL, fetch_temporal,
+                       PDO_SNOWFLAKE_FETCH_TEMPORAL_DATETIME),
+    PDO_SF_STMT_OPTION(FETCH_NUMBER, fetch_number,
+                       PDO_SNOWFLAKE_FETCH_NUMBER_NATIVE),
+    PDO_SF_STMT_OPTION(FETCH_VARIANT, fetch_variant,
+                       PDO_SNOWFLAKE_FETCH_VARIANT_OBJECT),
+    PDO_SF_STMT_OPTION(FETCH_BINARY, fetch_binary,
+                       PDO_SNOWFLAKE_FETCH_BINARY_RAW),
+    PDO_SF_STMT_OPTION(INTERN_STRINGS, intern_strings, ZEND_LONG_MAX)
+};
 
-void *_pdo_snowflake_user_calloc(size_t nitems, size_t size) /* {{{ */
-{
-    return ecalloc(nitems, size);
-}
-/* }}} */
+#define PDO_SF_STMT_OPTION_COUNT \
+    (sizeof(stmt_options) / sizeof(stmt_options[0]))
+
+#define PDO_SF_STMT_OPTION_FIELD(options, opt) \
+    ((zend_long *) ((char *) (options) + (opt)->offset))
 
-void *_pdo_snowflake_user_malloc(size_t size) /* {{{ */
+/**
+ * @param attr attribute
+ * @return the statement option of the attribute or NULL if none
+ */
+static const pdo_snowflake_stmt_option *
+_pdo_snowflake_find_stmt_option(zend_long attr) /* {{{ */
 {
-    return emalloc(size);
+    size_t i;
+
+    for (i = 0; i < PDO_SF_STMT_OPTION_COUNT; i++) {
+        if (stmt_options[i].attr == attr) {
+            return &stmt_options[i];
+        }
+    }
+    return NULL;
 }
 /* }}} */
 
-void _pdo_snowflake_user_dealloc(void* ptr) /* {{{ */
+/**
+ * Validate and set a statement option.
+ *
+ * @param dbh Pointer to the database handle to raise an error
+ * @param options statement options to be updated
+ * @param opt statement option
+ * @param value new value
+ * @return 1 if success or 0 if the value is invalid
+ */
+static int _pdo_snowflake_set_stmt_option(
+  pdo_dbh_t *dbh, pdo_snowflake_stmt_options *options,
+  const pdo_snowflake_stmt_option *opt, zend_long value) /* {{{ */
 {
-    efree(ptr);
+    if (value < 0 || value > opt->max) {
+        pdo_raise_impl_error(dbh, NULL, "HY024", opt->error);
+        return 0;
+    }
+    *PDO_SF_STMT_OPTION_FIELD(options, opt) = value;
+    return 1;
 }
-
+/* }}} */
 
 int _pdo_snowflake_error(pdo_dbh_t *dbh, pdo_stmt_t *stmt, const char *file,
                          int line) /* {{{ */
@@ -186,11 +235,27 @@ snowflake_handle_preparer(pdo_dbh_t *dbh, const char *sql, size_t sql_len,
     PDO_LOG_DBG("dbh=%p", dbh);
     PDO_LOG_DBG("sql=%.*s, len=%ld", (int) sql_len, sql, sql_len);
     pdo_snowflake_db_handle *H = (pdo_snowflake_db_handle *) dbh->driver_data;
+    pdo_snowflake_stmt_options options = H->options;
+    size_t i;
+
+    /* the driver options override the defaults of the connection */
+    for (i = 0; i < PDO_SF_STMT_OPTION_COUNT; i++) {
+        const pdo_snowflake_stmt_option *opt = &stmt_options[i];
+        zend_long value = pdo_attr_lval(
+            driver_options, (enum pdo_attribute_type) opt->attr,
+            *PDO_SF_STMT_OPTION_FIELD(&H->options, opt));
+        if (!_pdo_snowflake_set_stmt_option(dbh, &options, opt, value)) {
+            PDO_LOG_RETURN(0);
+        }
+    }
 
     /* allocate PDO stmt */
     pdo_snowflake_stmt *S = ecalloc(1, sizeof(pdo_snowflake_stmt));
 
     S->H = H;
+    S->describe_only = pdo_attr_lval(
+        driver_options, PDO_SNOWFLAKE_ATTR_DESCRIBE_ONLY, 0) ? 1 : 0;
+    S->options = options;
     stmt->driver_data = S;
     stmt->methods = &snowflake_stmt_methods;
 
@@ -365,8 +430,10 @@ static inline int snowflake_handle_autocommit(pdo_dbh_t *dbh) /* {{{ */
 static int
 pdo_snowflake_set_attribute(pdo_dbh_t *dbh, zend_long attr, zval *val) /* {{{ */
 {
+    pdo_snowflake_db_handle *H = (pdo_snowflake_db_handle *) dbh->driver_data;
     zend_long lval = zval_get_long(val);
     zend_bool bval = lval ? (zend_bool) 1 : (zend_bool) 0;
+    const pdo_snowflake_stmt_option *opt;
     PDO_LOG_ENTER("pdo_snowflake_set_attribute");
     PDO_LOG_DBG("dbh=%p, attr=%l", dbh, attr);
     switch (attr) {
@@ -382,6 +449,13 @@ pdo_snowflake_set_attribute(pdo_dbh_t *dbh, zend_long attr, zval *val) /* {{{ */
             PDO_LOG_RETURN(1);
             break;
         default:
+            opt = _pdo_snowflake_find_stmt_option(attr);
+            if (opt) {
+                int ret = _pdo_snowflake_set_stmt_option(
+                    dbh, &H->options, opt, lval);
+                PDO_LOG_DBG("value=%ld", lval);
+                PDO_LOG_RETURN(ret);
+            }
             PDO_LOG_DBG("unsupported attribute: %ld", attr);
             /* invalid attribute */
             PDO_LOG_RETURN(0);
@@ -395,6 +469,7 @@ static int
 pdo_snowflake_get_attribute(pdo_dbh_t *dbh, zend_long attr,
                             zval *return_value) {
     pdo_snowflake_db_handle *H = (pdo_snowflake_db_handle *) dbh->driver_data;
+    const pdo_snowflake_stmt_option *opt;
 
     PDO_LOG_ENTER("pdo_snowflake_get_attribute");
     PDO_LOG_DBG("dbh=%p", dbh);
@@ -404,7 +479,12 @@ pdo_snowflake_get_attribute(pdo_dbh_t *dbh, zend_long attr,
         case PDO_ATTR_AUTOCOMMIT: ZVAL_LONG(return_value, dbh->auto_commit);
             break;
         default:
-            /**/
+            opt = _pdo_snowflake_find_stmt_option(attr);
+            if (opt) {
+                ZVAL_LONG(return_value,
+                          *PDO_SF_STMT_OPTION_FIELD(&H->options, opt));
+                PDO_LOG_RETURN(1);
+            }
             PDO_LOG_RETURN(0);
     }
     PDO_LOG_RETURN(0);
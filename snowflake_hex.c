@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2017-2019 Snowflake Computing, Inc. All rights reserved.
+ */
+
+#include "snowflake_hex.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PDO_SF_HEX_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(PDO_SF_HEX_SSE2) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define PDO_SF_HEX_AVX2 1
+#include <immintrin.h>
+#endif
+
+typedef sf_bool (*hex_decode_fn)(const char *src, size_t len,
+                                 unsigned char *dst);
+
+/**
+ * The fastest decoder supported by the CPU. Set by pdo_sf_hex_init.
+ */
+static hex_decode_fn hex_decode = NULL;
+
+/**
+ * Value of a hex digit or -1 if the character is not a hex digit.
+ */
+static const signed char hex_values[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+/**
+ * Decode hex digits one byte at a time.
+ *
+ * @param src hex digits
+ * @param len the number of hex digits. Must be even.
+ * @param dst decoded bytes
+ * @return SF_BOOLEAN_TRUE if decoded or SF_BOOLEAN_FALSE if a character
+ * is not a hex digit.
+ */
+static sf_bool hex_decode_scalar(const char *src, size_t len,
+                                 unsigned char *dst) {
+    const unsigned char *s = (const unsigned char *) src;
+    size_t i;
+    int hi;
+    int lo;
+
+    for (i = 0; i < len; i += 2) {
+        hi = hex_values[s[i]];
+        lo = hex_values[s[i + 1]];
+        if ((hi | lo) < 0) {
+            return SF_BOOLEAN_FALSE;
+        }
+        *dst++ = (unsigned char) ((hi << 4) | lo);
+    }
+    return SF_BOOLEAN_TRUE;
+}
+
+#ifdef PDO_SF_HEX_SSE2
+/**
+ * Convert 16 hex digits to their values in 16-bit lanes, i.e., the
+ * value of the first digit of a pair in the high nibble of the low byte
+ * and the second one in the low nibble.
+ *
+ * @param v hex digits
+ * @param valid cleared if a character is not a hex digit
+ * @return 8 decoded bytes, one in each 16-bit lane
+ */
+static __m128i hex_nibbles_sse2(__m128i v, int *valid) {
+    __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('0' - 1)),
+                                  _mm_cmplt_epi8(v, _mm_set1_epi8('9' + 1)));
+    __m128i alpha = _mm_and_si128(
+      _mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+      _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    __m128i nibbles = _mm_or_si128(
+      _mm_and_si128(digit, _mm_sub_epi8(v, _mm_set1_epi8('0'))),
+      _mm_and_si128(alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+
+    if (_mm_movemask_epi8(_mm_or_si128(digit, alpha)) != 0xFFFF) {
+        *valid = 0;
+    }
+    return _mm_or_si128(
+      _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4),
+      _mm_srli_epi16(nibbles, 8));
+}
+
+/**
+ * Decode hex digits 32 at a time with SSE2.
+ *
+ * @param src hex digits
+ * @param len the number of hex digits. Must be even.
+ * @param dst decoded bytes
+ * @return SF_BOOLEAN_TRUE if decoded or SF_BOOLEAN_FALSE if a character
+ * is not a hex digit.
+ */
+static sf_bool hex_decode_sse2(const char *src, size_t len,
+                               unsigned char *dst) {
+    int valid = 1;
+    __m128i a;
+    __m128i b;
+
+    for (; len >= 32; len -= 32, src += 32, dst += 16) {
+        a = hex_nibbles_sse2(_mm_loadu_si128((const __m128i *) src), &valid);
+        b = hex_nibbles_sse2(_mm_loadu_si128((const __m128i *) (src + 16)),
+                             &valid);
+        if (!valid) {
+            return SF_BOOLEAN_FALSE;
+        }
+        _mm_storeu_si128((__m128i *) dst, _mm_packus_epi16(a, b));
+    }
+    return hex_decode_scalar(src, len, dst);
+}
+#endif
+
+#ifdef PDO_SF_HEX_AVX2
+/**
+ * Convert 32 hex digits to their values in 16-bit lanes.
+ *
+ * @see hex_nibbles_sse2
+ */
+__attribute__((target("avx2")))
+static __m256i hex_nibbles_avx2(__m256i v, int *valid) {
+    __m256i lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+    __m256i digit = _mm256_andnot_si256(
+      _mm256_cmpgt_epi8(v, _mm256_set1_epi8('9')),
+      _mm256_cmpgt_epi8(v, _mm256_set1_epi8('0' - 1)));
+    __m256i alpha = _mm256_andnot_si256(
+      _mm256_cmpgt_epi8(lower, _mm256_set1_epi8('f')),
+      _mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)));
+    __m256i nibbles = _mm256_or_si256(
+      _mm256_and_si256(digit, _mm256_sub_epi8(v, _mm256_set1_epi8('0'))),
+      _mm256_and_si256(alpha,
+                       _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10))));
+
+    if (_mm256_movemask_epi8(_mm256_or_si256(digit, alpha)) != -1) {
+        *valid = 0;
+    }
+    return _mm256_or_si256(
+      _mm256_slli_epi16(_mm256_and_si256(nibbles, _mm256_set1_epi16(0x00FF)),
+                        4),
+      _mm256_srli_epi16(nibbles, 8));
+}
+
+/**
+ * Decode hex digits 64 at a time with AVX2.
+ *
+ * @see hex_decode_sse2
+ */
+__attribute__((target("avx2")))
+static sf_bool hex_decode_avx2(const char *src, size_t len,
+                               unsigned char *dst) {
+    int valid = 1;
+    __m256i a;
+    __m256i b;
+
+    for (; len >= 64; len -= 64, src += 64, dst += 32) {
+        a = hex_nibbles_avx2(_mm256_loadu_si256((const __m256i *) src),
+                             &valid);
+        b = hex_nibbles_avx2(_mm256_loadu_si256((const __m256i *) (src + 32)),
+                             &valid);
+        if (!valid) {
+            return SF_BOOLEAN_FALSE;
+        }
+        /* packus works in each 128-bit lane */
+        _mm256_storeu_si256(
+          (__m256i *) dst,
+          _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8));
+    }
+    return hex_decode_sse2(src, len, dst);
+}
+#endif
+
+/**
+ * Select the hex decoder for the CPU. Must be called once before
+ * pdo_sf_hex_decode.
+ */
+void STDCALL pdo_sf_hex_init() {
+    hex_decode = hex_decode_scalar;
+#ifdef PDO_SF_HEX_SSE2
+    hex_decode = hex_decode_sse2;
+#endif
+#ifdef PDO_SF_HEX_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        hex_decode = hex_decode_avx2;
+    }
+#endif
+}
+
+/**
+ * Decode hex digits to bytes.
+ *
+ * @param src hex digits
+ * @param len the number of hex digits
+ * @param dst buffer of len / 2 bytes
+ * @return SF_BOOLEAN_TRUE if decoded or SF_BOOLEAN_FALSE if the length is
+ * odd or a character is not a hex digit.
+ */
+sf_bool STDCALL pdo_sf_hex_decode(const char *src, size_t len,
+                                  unsigned char *dst) {
+    if (len % 2 != 0) {
+        return SF_BOOLEAN_FALSE;
+    }
+    if (hex_decode == NULL) {
+        return hex_decode_scalar(src, len, dst);
+    }
+    return hex_decode(src, len, dst);
+}
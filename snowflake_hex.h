@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2017-2019 Snowflake Computing, Inc. All rights reserved.
+ */
+
+#ifndef PHP_PDO_SNOWFLAKE_HEX_H
+#define PHP_PDO_SNOWFLAKE_HEX_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+#if !defined(_WIN32)
+#define STDCALL
+#else
+#define STDCALL __stdcall
+#endif
+
+#include <stdlib.h>
+#include <snowflake/client.h>
+
+void STDCALL pdo_sf_hex_init();
+sf_bool STDCALL pdo_sf_hex_decode(const char *src, size_t len,
+                                  unsigned char *dst);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif //PHP_PDO_SNOWFLAKE_HEX_H
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2017-2019 Snowflake Computing, Inc. All rights reserved.
+ */
+
+#include <string.h>
+#include "snowflake_memory.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#define PDO_SF_ATOMIC_ADD(p, v) \
+    InterlockedExchangeAddSizeT((p), (v))
+#define PDO_SF_ATOMIC_SUB(p, v) \
+    InterlockedExchangeAddSizeT((p), (size_t) 0 - (v))
+#define PDO_SF_ATOMIC_CAS(p, expected, desired) \
+    (InterlockedCompareExchangePointer((PVOID volatile *) (p), \
+                                       (PVOID) (desired), \
+                                       (PVOID) (expected)) == \
+     (PVOID) (expected))
+#else
+#define PDO_SF_ATOMIC_ADD(p, v) __atomic_fetch_add((p), (v), __ATOMIC_RELAXED)
+#define PDO_SF_ATOMIC_SUB(p, v) __atomic_fetch_sub((p), (v), __ATOMIC_RELAXED)
+#define PDO_SF_ATOMIC_CAS(p, expected, desired) \
+    __atomic_compare_exchange_n((p), &(expected), (desired), 0, \
+                                __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#endif
+
+/**
+ * Header of the memory blocks allocated for the client. The size of the
+ * block is kept to account the memory usage when the block is released.
+ */
+typedef union {
+    size_t size;
+    char align[16]; /* keeps the blocks aligned as malloc does */
+} pdo_sf_memory_header;
+
+#define PDO_SF_MEMORY_MAX_SIZE ((size_t) -1 - sizeof(pdo_sf_memory_header))
+
+/**
+ * The client library allocates the memory from the threads that download
+ * the result chunks and transfer the files as well as from the PHP thread.
+ * The Zend memory manager is not thread safe, so the memory is allocated by
+ * malloc and accounted here instead of memory_limit.
+ *
+ * The usage is only reported. The client doesn't check for NULL from the
+ * hooks, so failing an allocation on a limit would crash the process.
+ */
+static volatile size_t memory_usage = 0;
+static volatile size_t memory_peak_usage = 0;
+
+/**
+ * Account the memory allocated.
+ *
+ * @param size the number of bytes
+ */
+static void memory_reserve(size_t size) {
+    size_t usage = PDO_SF_ATOMIC_ADD(&memory_usage, size) + size;
+    size_t peak = memory_peak_usage;
+
+    while (usage > peak && !PDO_SF_ATOMIC_CAS(&memory_peak_usage, peak, usage)) {
+        peak = memory_peak_usage;
+    }
+}
+
+/**
+ * Account the memory released.
+ *
+ * @param size the number of bytes
+ */
+static void memory_release(size_t size) {
+    PDO_SF_ATOMIC_SUB(&memory_usage, size);
+}
+
+/**
+ * @return the number of bytes allocated for the client
+ */
+size_t STDCALL pdo_sf_memory_usage() {
+    return memory_usage;
+}
+
+/**
+ * @return the peak number of bytes allocated for the client
+ */
+size_t STDCALL pdo_sf_memory_peak_usage() {
+    return memory_peak_usage;
+}
+
+void *_pdo_snowflake_user_malloc(size_t size) /* {{{ */
+{
+    pdo_sf_memory_header *block;
+
+    if (size > PDO_SF_MEMORY_MAX_SIZE) {
+        return NULL;
+    }
+    block = malloc(sizeof(pdo_sf_memory_header) + size);
+    if (block == NULL) {
+        return NULL;
+    }
+    memory_reserve(size);
+    block->size = size;
+    return block + 1;
+}
+/* }}} */
+
+void *_pdo_snowflake_user_calloc(size_t nitems, size_t size) /* {{{ */
+{
+    void *ptr;
+
+    if (size != 0 && nitems > PDO_SF_MEMORY_MAX_SIZE / size) {
+        return NULL;
+    }
+    ptr = _pdo_snowflake_user_malloc(nitems * size);
+    if (ptr) {
+        memset(ptr, 0, nitems * size);
+    }
+    return ptr;
+}
+/* }}} */
+
+void *_pdo_snowflake_user_realloc(void* org_ptr, size_t new_size) /* {{{ */
+{
+    pdo_sf_memory_header *block;
+    size_t old_size;
+
+    if (org_ptr == NULL) {
+        return _pdo_snowflake_user_malloc(new_size);
+    }
+    block = (pdo_sf_memory_header *) org_ptr - 1;
+    old_size = block->size;
+    if (new_size > PDO_SF_MEMORY_MAX_SIZE) {
+        return NULL;
+    }
+    block = realloc(block, sizeof(pdo_sf_memory_header) + new_size);
+    if (block == NULL) {
+        return NULL;
+    }
+    if (new_size > old_size) {
+        memory_reserve(new_size - old_size);
+    } else {
+        memory_release(old_size - new_size);
+    }
+    block->size = new_size;
+    return block + 1;
+}
+/* }}} */
+
+void _pdo_snowflake_user_dealloc(void* ptr) /* {{{ */
+{
+    pdo_sf_memory_header *block;
+
+    if (ptr == NULL) {
+        return;
+    }
+    block = (pdo_sf_memory_header *) ptr - 1;
+    memory_release(block->size);
+    free(block);
+}
+/* }}} */
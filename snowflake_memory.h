@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2017-2019 Snowflake Computing, Inc. All rights reserved.
+ */
+
+#ifndef PHP_PDO_SNOWFLAKE_MEMORY_H
+#define PHP_PDO_SNOWFLAKE_MEMORY_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+#if !defined(_WIN32)
+#define STDCALL
+#else
+#define STDCALL __stdcall
+#endif
+
+#include <stdlib.h>
+
+size_t STDCALL pdo_sf_memory_usage();
+size_t STDCALL pdo_sf_memory_peak_usage();
+
+/* memory hooks of the client */
+void *_pdo_snowflake_user_realloc(void* org_ptr, size_t new_size);
+void *_pdo_snowflake_user_calloc(size_t nitems, size_t size);
+void *_pdo_snowflake_user_malloc(size_t size);
+void _pdo_snowflake_user_dealloc(void* ptr);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif //PHP_PDO_SNOWFLAKE_MEMORY_H
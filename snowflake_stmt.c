@@ -6,6 +6,9 @@
 #include "php.h"
 #include "pdo/php_pdo_driver.h"
 #include "php_pdo_snowflake_int.h"
+#include "ext/json/php_json.h"
+#include "snowflake_hex.h"
+#include "snowflake_temporal.h"
 
 /**
  * Mapping event enum to name
@@ -61,6 +64,70 @@ static void _pdo_snowflake_stmt_set_row_count(pdo_stmt_t *stmt) /* {{{ */
 }
 /* }}} */
 
+/**
+ * Release the string buffers bound to the result columns.
+ *
+ * @param stmt Pointer to the statement structure initialized by handle_preparer.
+ */
+static void _pdo_snowflake_stmt_free_bound_results(pdo_stmt_t *stmt) /* {{{ */
+{
+    pdo_snowflake_stmt *S = stmt->driver_data;
+
+    if (S->bound_results) {
+        /* allocated by the client */
+        for(int i = 0; i < stmt->column_count; i++) {
+            _pdo_snowflake_user_dealloc(S->bound_results[i].value);
+        }
+        efree(S->bound_results);
+        S->bound_results = NULL;
+    }
+    if (S->column_formats) {
+        efree(S->column_formats);
+        S->column_formats = NULL;
+    }
+    if (S->interned) {
+        for(int i = 0; i < stmt->column_count; i++) {
+            if (S->interned[i]) {
+                zend_hash_destroy(S->interned[i]);
+                efree(S->interned[i]);
+            }
+        }
+        efree(S->interned);
+        S->interned = NULL;
+    }
+}
+/* }}} */
+
+/**
+ * Describe the prepared query without running it.
+ *
+ * Snowflake compiles the query and returns the result set metadata only,
+ * so no warehouse is used and no rows are downloaded. The column
+ * descriptions become available through snowflake_desc as if the query
+ * had been executed.
+ *
+ * @param S Snowflake statement
+ * @return SF_STATUS_SUCCESS if success or an error status
+ */
+static SF_STATUS _pdo_snowflake_stmt_describe_only(pdo_snowflake_stmt *S) /* {{{ */
+{
+    SF_QUERY_RESULT_CAPTURE *capture = NULL;
+    SF_STATUS ret;
+
+    PDO_LOG_ENTER("_pdo_snowflake_stmt_describe_only");
+    snowflake_query_result_capture_init(&capture);
+    if (capture == NULL) {
+        PDO_LOG_RETURN(SF_STATUS_ERROR_OUT_OF_MEMORY);
+    }
+    ret = snowflake_describe_with_capture(S->stmt, capture);
+    /* The raw response is not used. It is allocated by the client's JSON
+     * printer with the C runtime allocator, not with emalloc. */
+    free(capture->capture_buffer);
+    snowflake_query_result_capture_term(capture);
+    PDO_LOG_RETURN(ret);
+}
+/* }}} */
+
 /**
  * Destroy a previously constructed statement object.
  *
@@ -80,13 +147,7 @@ static int pdo_snowflake_stmt_dtor(pdo_stmt_t *stmt) /* {{{ */
         pdo_sf_param_store_deallocate(S->bound_params);
     }
 
-    // Release string bindings
-    if (S->bound_results) {
-        for(int i = 0; i < stmt->column_count; i++) {
-            efree(S->bound_results[i].value);
-        }
-        efree(S->bound_results);
-    }
+    _pdo_snowflake_stmt_free_bound_results(stmt);
 
     PDO_LOG_DBG("number of columns: %d", stmt->column_count);
     snowflake_stmt_term(S->stmt);
@@ -108,10 +169,22 @@ static int pdo_snowflake_stmt_execute_prepared(pdo_stmt_t *stmt) /* {{{ */
 {
     PDO_LOG_ENTER("pdo_snowflake_stmt_execute_prepared");
     int i;
+    SF_STATUS status;
+    SF_COLUMN_DESC *F;
     pdo_snowflake_stmt *S = stmt->driver_data;
 
+    /* release the bindings of the previous execution if any */
+    _pdo_snowflake_stmt_free_bound_results(stmt);
+    S->timezone_loaded = 0;
+    S->row_position = 0;
+
     /* execute */
-    if (snowflake_execute(S->stmt) != SF_STATUS_SUCCESS) {
+    if (S->describe_only) {
+        status = _pdo_snowflake_stmt_describe_only(S);
+    } else {
+        status = snowflake_execute(S->stmt);
+    }
+    if (status != SF_STATUS_SUCCESS) {
         pdo_snowflake_error_stmt(stmt);
         PDO_LOG_RETURN(0);
     }
@@ -127,7 +200,40 @@ static int pdo_snowflake_stmt_execute_prepared(pdo_stmt_t *stmt) /* {{{ */
         S->bound_results[i].size = 0;
     }
 
-    _pdo_snowflake_stmt_set_row_count(stmt);
+    /* DATE, TIME and TIMESTAMP columns may be formatted by the driver, and
+     * the text columns are the raw values in the result */
+    S->column_formats = emalloc((size_t) stmt->column_count);
+    F = snowflake_desc(S->stmt);
+    for(i = 0; i < stmt->column_count; i++) {
+        switch (F[i].type) {
+            case SF_DB_TYPE_DATE:
+            case SF_DB_TYPE_TIME:
+            case SF_DB_TYPE_TIMESTAMP_NTZ:
+            case SF_DB_TYPE_TIMESTAMP_LTZ:
+            case SF_DB_TYPE_TIMESTAMP_TZ:
+                S->column_formats[i] = PDO_SNOWFLAKE_FORMAT_UNKNOWN;
+                break;
+            case SF_DB_TYPE_TEXT:
+            case SF_DB_TYPE_VARIANT:
+            case SF_DB_TYPE_OBJECT:
+            case SF_DB_TYPE_ARRAY:
+            case SF_DB_TYPE_BINARY:
+                S->column_formats[i] = PDO_SNOWFLAKE_FORMAT_RAW;
+                break;
+            default:
+                S->column_formats[i] = PDO_SNOWFLAKE_FORMAT_CLIENT;
+                break;
+        }
+    }
+
+    /* the string caches are created by the first value of each column */
+    if (S->options.intern_strings > 0) {
+        S->interned = ecalloc((size_t) stmt->column_count, sizeof(HashTable *));
+    }
+
+    if (!S->describe_only) {
+        _pdo_snowflake_stmt_set_row_count(stmt);
+    }
     PDO_LOG_RETURN(1);
 }
 /* }}} */
@@ -173,6 +279,11 @@ static int pdo_snowflake_stmt_execute(pdo_stmt_t *stmt) /* {{{ */
  * scrollable cursor. This function returns 1 for success or 0 in the event
  * of failure.
  *
+ * The cursor is forward only. PDO_FETCH_ORI_FIRST, PDO_FETCH_ORI_ABS and
+ * PDO_FETCH_ORI_REL skip the rows up to the 1-based row number without
+ * converting any column, and the current row may be fetched again. Moving
+ * backward, PDO_FETCH_ORI_PRIOR and PDO_FETCH_ORI_LAST raise an error.
+ *
  * @param stmt Pointer to the statement structure initialized by handle_preparer.
  * @param ori One of PDO_FETCH_ORI_xxx which will determine which row will
  * be fetched.
@@ -188,21 +299,90 @@ static int pdo_snowflake_stmt_fetch(
     PDO_LOG_ENTER("pdo_snowflake_stmt_fetch");
     PDO_LOG_DBG("ori: %d, offset: %d", ori, offset);
     pdo_snowflake_stmt *S = (pdo_snowflake_stmt *) stmt->driver_data;
-    if (ori != PDO_FETCH_ORI_NEXT) {
-        /* TODO: raise error */
+    zend_long target;
+    SF_STATUS ret;
+
+    switch (ori) {
+        case PDO_FETCH_ORI_NEXT:
+            target = S->row_position + 1;
+            break;
+        case PDO_FETCH_ORI_FIRST:
+            target = 1;
+            break;
+        case PDO_FETCH_ORI_ABS:
+            target = offset;
+            break;
+        case PDO_FETCH_ORI_REL:
+            if (offset > ZEND_LONG_MAX - S->row_position) {
+                /* no row can be numbered beyond ZEND_LONG_MAX */
+                target = 0;
+                break;
+            }
+            target = S->row_position + offset;
+            break;
+        default:
+            target = 0;
+            break;
     }
-    SF_STATUS ret = snowflake_fetch(S->stmt);
-    if (ret == SF_STATUS_EOF) {
-        PDO_LOG_DBG("EOL");
+    if (target < S->row_position || target < 1) {
+        pdo_raise_impl_error(stmt->dbh, stmt, "HY106",
+                             "The cursor is forward only");
         PDO_LOG_RETURN(0);
-    } else if (ret != SF_STATUS_SUCCESS) {
-        PDO_LOG_DBG("ERROR 1");
+    }
+    if (S->describe_only) {
+        /* no row is returned for the describe only query */
+        PDO_LOG_DBG("EOL");
         PDO_LOG_RETURN(0);
     }
+    /* the current row is still in the result */
+    while (S->row_position < target) {
+        ret = snowflake_fetch(S->stmt);
+        if (ret == SF_STATUS_EOF) {
+            PDO_LOG_DBG("EOL");
+            PDO_LOG_RETURN(0);
+        } else if (ret != SF_STATUS_SUCCESS) {
+            PDO_LOG_DBG("ERROR 1");
+            PDO_LOG_RETURN(0);
+        }
+        S->row_position++;
+    }
     PDO_LOG_RETURN(1);
 }
 /* }}} */
 
+/**
+ * Check if the column is fetched as other than a string.
+ *
+ * @param S Snowflake statement
+ * @param type column data type
+ * @return 1 if the column is fetched as a typed value or 0 otherwise
+ */
+static int _pdo_snowflake_stmt_is_typed_column(
+  pdo_snowflake_stmt *S, SF_DB_TYPE type) /* {{{ */
+{
+    switch (type) {
+        case SF_DB_TYPE_DATE:
+        case SF_DB_TYPE_TIME:
+        case SF_DB_TYPE_TIMESTAMP_NTZ:
+        case SF_DB_TYPE_TIMESTAMP_LTZ:
+        case SF_DB_TYPE_TIMESTAMP_TZ:
+            return S->options.fetch_temporal != PDO_SNOWFLAKE_FETCH_TEMPORAL_STRING;
+        case SF_DB_TYPE_FIXED:
+            return S->options.fetch_number != PDO_SNOWFLAKE_FETCH_NUMBER_STRING;
+        case SF_DB_TYPE_VARIANT:
+        case SF_DB_TYPE_OBJECT:
+        case SF_DB_TYPE_ARRAY:
+            return S->options.fetch_variant != PDO_SNOWFLAKE_FETCH_VARIANT_STRING;
+        case SF_DB_TYPE_BINARY:
+            return S->options.fetch_binary != PDO_SNOWFLAKE_FETCH_BINARY_HEX;
+        case SF_DB_TYPE_TEXT:
+            return S->options.intern_strings > 0;
+        default:
+            return 0;
+    }
+}
+/* }}} */
+
 /**
  * Query information about a particular column.
  *
@@ -216,9 +396,9 @@ static int pdo_snowflake_stmt_fetch(
  */
 static int pdo_snowflake_stmt_describe(pdo_stmt_t *stmt, int colno) /* {{{ */
 {
-    int i;
     pdo_snowflake_stmt *S = (pdo_snowflake_stmt *) stmt->driver_data;
-    struct pdo_column_data *cols = stmt->columns;
+    struct pdo_column_data *col;
+    SF_COLUMN_DESC *F;
     PDO_LOG_ENTER("pdo_snowflake_stmt_describe");
     PDO_LOG_DBG("colno %d", colno);
     if (colno >= stmt->column_count) {
@@ -227,75 +407,478 @@ static int pdo_snowflake_stmt_describe(pdo_stmt_t *stmt, int colno) /* {{{ */
                     stmt->column_count, colno);
         PDO_LOG_RETURN(0);
     }
-    SF_COLUMN_DESC *F = snowflake_desc(S->stmt);
-    for (i = 0; i < stmt->column_count; i++) {
-        cols[i].precision = (zend_ulong) F[i].precision;
-        switch (F[i].type) {
-            case SF_DB_TYPE_OBJECT:
-            case SF_DB_TYPE_ARRAY:
-            case SF_DB_TYPE_VARIANT:
-                /* No size is given from the server */
-                cols[i].maxlen = SF_MAX_OBJECT_SIZE;
-                break;
-            case SF_DB_TYPE_BOOLEAN:
-                cols[i].maxlen =
-                  (sizeof(SF_BOOLEAN_TRUE_STR) > sizeof(SF_BOOLEAN_FALSE_STR)
-                   ? sizeof(SF_BOOLEAN_TRUE_STR)
-                   : sizeof(SF_BOOLEAN_FALSE_STR)) - 1;
-                break;
-            case SF_DB_TYPE_BINARY:
-                cols[i].maxlen = (size_t) F[i].byte_size;
-                break;
-            case SF_DB_TYPE_DATE:
-            case SF_DB_TYPE_TIMESTAMP_NTZ:
-            case SF_DB_TYPE_TIMESTAMP_TZ:
-            case SF_DB_TYPE_TIMESTAMP_LTZ:
-            case SF_DB_TYPE_TIME:
-                /* length doesn't matter to allocate buffer */
-                cols[i].maxlen = (size_t) F[i].byte_size;
-                break;
-            default:
-                cols[i].maxlen = (size_t) F[i].byte_size;
-                break;
-        }
-        cols[i].name = zend_string_init(
-          F[i].name, strlen(F[i].name), 0);
+    col = &stmt->columns[colno];
+    F = &snowflake_desc(S->stmt)[colno];
+    col->precision = (zend_ulong) F->precision;
+    switch (F->type) {
+        case SF_DB_TYPE_OBJECT:
+        case SF_DB_TYPE_ARRAY:
+        case SF_DB_TYPE_VARIANT:
+            /* No size is given from the server */
+            col->maxlen = SF_MAX_OBJECT_SIZE;
+            break;
+        case SF_DB_TYPE_BOOLEAN:
+            col->maxlen =
+              (sizeof(SF_BOOLEAN_TRUE_STR) > sizeof(SF_BOOLEAN_FALSE_STR)
+               ? sizeof(SF_BOOLEAN_TRUE_STR)
+               : sizeof(SF_BOOLEAN_FALSE_STR)) - 1;
+            break;
+        case SF_DB_TYPE_BINARY:
+            col->maxlen = (size_t) F->byte_size;
+            break;
+        case SF_DB_TYPE_DATE:
+        case SF_DB_TYPE_TIMESTAMP_NTZ:
+        case SF_DB_TYPE_TIMESTAMP_TZ:
+        case SF_DB_TYPE_TIMESTAMP_LTZ:
+        case SF_DB_TYPE_TIME:
+            /* length doesn't matter to allocate buffer */
+            col->maxlen = (size_t) F->byte_size;
+            break;
+        default:
+            col->maxlen = (size_t) F->byte_size;
+            break;
+    }
+    /* The name is the key of the column in every associative row. An
+     * interned name is hashed once and isn't reference counted by the
+     * rows. Before PHP 8.0, PDO applies PDO::ATTR_CASE by changing the name
+     * in place, which must not be done to a shared interned string or to a
+     * string with the hash already computed. */
+#if (PHP_VERSION_ID >= 80000)
+    if (stmt->dbh->desired_case == PDO_CASE_NATURAL) {
+        col->name = zend_string_init_interned(F->name, strlen(F->name), 0);
+    } else {
+        col->name = zend_string_init(F->name, strlen(F->name), 0);
+    }
+#else
+    col->name = zend_string_init(F->name, strlen(F->name), 0);
+#endif
 #if (PHP_VERSION_ID < 80100)
-        cols[i].param_type = PDO_PARAM_STR; /* Always string */
+    col->param_type =
+      _pdo_snowflake_stmt_is_typed_column(S, F->type)
+      ? PDO_PARAM_ZVAL : PDO_PARAM_STR;
 #endif
-    }
     PDO_LOG_RETURN(1);
 }
 /* }}} */
 
 /**
- * Retrieve data from the specified column.
+ * Get the UTC offset of the local time of a DATE, TIME or TIMESTAMP value.
+ * DATE, TIME and TIMESTAMP_NTZ values have no offset.
  *
- * The driver should return the result data and length of that data in the
- * ptr and len variables respectively. It should be noted that the main PDO
- * driver expects the driver to manage the lifetime of the data. This function
- * returns 1 for success or 0 in the event of failure.
+ * TIMESTAMP_LTZ values are in the session time zone, of which the offset
+ * rules are cached by name, so that no TZ environment variable is set to
+ * convert the values.
+ *
+ * @param S Snowflake statement
+ * @param type column data type
+ * @param value decoded value
+ * @param gmtoff seconds east of UTC
+ * @return 1 if found or 0 to convert the value by the client
+ */
+static int _pdo_snowflake_stmt_local_offset(
+  pdo_snowflake_stmt *S, SF_DB_TYPE type, const PDO_SF_TEMPORAL *value,
+  int32 *gmtoff) /* {{{ */
+{
+    switch (type) {
+        case SF_DB_TYPE_DATE:
+        case SF_DB_TYPE_TIME:
+        case SF_DB_TYPE_TIMESTAMP_NTZ:
+            *gmtoff = 0;
+            return 1;
+        case SF_DB_TYPE_TIMESTAMP_TZ:
+            *gmtoff = value->tzoffset * 60;
+            return 1;
+        case SF_DB_TYPE_TIMESTAMP_LTZ:
+            break;
+        default:
+            return 0;
+    }
+    if (!S->timezone_loaded) {
+        S->timezone = pdo_sf_timezone_find(&PDO_SNOWFLAKE_G(timezones),
+                                           S->H->server->timezone);
+        S->timezone_loaded = 1;
+    }
+    return S->timezone != NULL &&
+           pdo_sf_timezone_offset(S->timezone, value->sec, gmtoff);
+}
+/* }}} */
+
+/**
+ * Format a DATE, TIME or TIMESTAMP column to the same string as
+ * snowflake_column_as_str does.
+ *
+ * Whether the column is in the raw format is decided by the first value
+ * of the result. Columns of an Arrow result are formatted by the client.
+ *
+ * @param S Snowflake statement
+ * @param colno The column number to be queried.
+ * @param F column description
+ * @param str buffer of the column
+ * @param len the length of the string
+ * @return 1 if formatted or 0 to format the value by the client
+ */
+static int _pdo_snowflake_stmt_format_temporal(
+  pdo_snowflake_stmt *S, int colno, const SF_COLUMN_DESC *F,
+  pdo_snowflake_string *str, size_t *len) /* {{{ */
+{
+    const char *raw = NULL;
+    PDO_SF_TEMPORAL value;
+    int32 gmtoff;
+
+    snowflake_column_as_const_str(S->stmt, colno + 1, &raw);
+    if (raw == NULL || !pdo_sf_temporal_from_raw(F->type, raw, &value)) {
+        if (S->column_formats[colno] == PDO_SNOWFLAKE_FORMAT_UNKNOWN) {
+            S->column_formats[colno] = PDO_SNOWFLAKE_FORMAT_CLIENT;
+        }
+        return 0;
+    }
+    S->column_formats[colno] = PDO_SNOWFLAKE_FORMAT_DRIVER;
+    if (!_pdo_snowflake_stmt_local_offset(S, F->type, &value, &gmtoff)) {
+        return 0;
+    }
+    if (str->size < PDO_SF_TEMPORAL_STR_SIZE) {
+        /* same allocator as the client uses for the buffer */
+        char *buf = _pdo_snowflake_user_realloc(str->value,
+                                                PDO_SF_TEMPORAL_STR_SIZE);
+        if (buf == NULL) {
+            return 0;
+        }
+        str->value = buf;
+        str->size = PDO_SF_TEMPORAL_STR_SIZE;
+    }
+    *len = pdo_sf_temporal_to_str(F->type, &value, gmtoff, F->scale,
+                                  str->value);
+    return *len > 0;
+}
+/* }}} */
+
+/**
+ * Retrieve a DATE, TIME or TIMESTAMP column as the type specified by
+ * PDO_SNOWFLAKE_ATTR_FETCH_TEMPORAL.
+ *
+ * The raw value in the result is decoded without formatting it to a
+ * string. If the value is not in the raw format, it is converted by
+ * snowflake_column_as_timestamp.
+ *
+ * @param S Snowflake statement
+ * @param colno The column number to be queried.
+ * @param type column data type
+ * @param result Holds the retrieved value.
+ * @return 1 if retrieved or 0 to retrieve the value as a string
+ */
+static int _pdo_snowflake_stmt_get_temporal(
+  pdo_snowflake_stmt *S, int colno, SF_DB_TYPE type, zval *result) /* {{{ */
+{
+    const char *raw = NULL;
+    PDO_SF_TEMPORAL value;
+    SF_TIMESTAMP ts;
+    int32 gmtoff;
+
+    if (S->options.fetch_temporal == PDO_SNOWFLAKE_FETCH_TEMPORAL_DATETIME &&
+        type == SF_DB_TYPE_TIME) {
+        /* TIME has no date */
+        return 0;
+    }
+    snowflake_column_as_const_str(S->stmt, colno + 1, &raw);
+    if (raw == NULL || !pdo_sf_temporal_from_raw(type, raw, &value)) {
+        if (snowflake_column_as_timestamp(S->stmt, colno + 1, &ts) !=
+            SF_STATUS_SUCCESS) {
+            return 0;
+        }
+        pdo_sf_temporal_from_timestamp(type, &ts, &value);
+    } else if (type == SF_DB_TYPE_TIMESTAMP_LTZ &&
+               S->options.fetch_temporal == PDO_SNOWFLAKE_FETCH_TEMPORAL_DATETIME) {
+        /* The offset depends on the session time zone */
+        if (_pdo_snowflake_stmt_local_offset(S, type, &value, &gmtoff)) {
+            value.tzoffset = gmtoff / 60;
+        } else if (snowflake_column_as_timestamp(S->stmt, colno + 1, &ts) ==
+                   SF_STATUS_SUCCESS) {
+            value.tzoffset = ts.tzoffset;
+        } else {
+            return 0;
+        }
+    }
+
+    switch (S->options.fetch_temporal) {
+        case PDO_SNOWFLAKE_FETCH_TEMPORAL_EPOCH_SECONDS:
+            pdo_sf_temporal_to_epoch_seconds(&value, result);
+            break;
+        case PDO_SNOWFLAKE_FETCH_TEMPORAL_EPOCH_NANOSECONDS:
+            pdo_sf_temporal_to_epoch_nanoseconds(&value, result);
+            break;
+        case PDO_SNOWFLAKE_FETCH_TEMPORAL_DATETIME:
+            pdo_sf_temporal_to_datetime(&value, result);
+            break;
+        default:
+            return 0;
+    }
+    return 1;
+}
+/* }}} */
+
+/**
+ * Retrieve a NUMBER column as an integer if the scale is 0 and the value
+ * fits in the PHP integer, or as the exact decimal string otherwise.
+ *
+ * The decimal text of the raw value is converted with the integer
+ * arithmetic, so no value is rounded through a floating point number.
+ *
+ * @param S Snowflake statement
+ * @param colno The column number to be queried.
+ * @param scale column scale
+ * @param result Holds the retrieved value.
+ * @return 1 if retrieved or 0 to retrieve the value as a string
+ */
+static int _pdo_snowflake_stmt_get_number(
+  pdo_snowflake_stmt *S, int colno, int64 scale, zval *result) /* {{{ */
+{
+    const char *raw = NULL;
+    const char *p;
+    const char *digits;
+    zend_bool negative;
+    zend_ulong limit;
+    zend_ulong value = 0;
+    zend_ulong digit;
+
+    snowflake_column_as_const_str(S->stmt, colno + 1, &raw);
+    if (raw == NULL) {
+        return 0;
+    }
+    p = raw;
+    negative = *p == '-';
+    if (negative) {
+        p++;
+    }
+    digits = p;
+    while (*p >= '0' && *p <= '9') {
+        p++;
+    }
+    if (p == digits) {
+        return 0;
+    }
+    if (scale == 0 && *p == '\0') {
+        /* the magnitude of ZEND_LONG_MIN is ZEND_LONG_MAX + 1 */
+        limit = (zend_ulong) ZEND_LONG_MAX + (negative ? 1 : 0);
+        for (p = digits; *p != '\0'; p++) {
+            digit = (zend_ulong) (*p - '0');
+            if (value > (limit - digit) / 10) {
+                /* out of range of the PHP integer */
+                ZVAL_STRINGL(result, raw, strlen(raw));
+                return 1;
+            }
+            value = value * 10 + digit;
+        }
+        if (!negative) {
+            ZVAL_LONG(result, (zend_long) value);
+        } else if (value == 0) {
+            ZVAL_LONG(result, 0);
+        } else {
+            ZVAL_LONG(result, -(zend_long) (value - 1) - 1);
+        }
+        return 1;
+    }
+    if (*p == '.') {
+        digits = ++p;
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+        if (p == digits) {
+            return 0;
+        }
+    }
+    if (*p != '\0') {
+        return 0;
+    }
+    ZVAL_STRINGL(result, raw, (size_t) (p - raw));
+    return 1;
+}
+/* }}} */
+
+/**
+ * Retrieve a VARIANT, OBJECT or ARRAY column as a PHP value decoded from
+ * the JSON text in the result. JSON objects are decoded to associative
+ * arrays or stdClass objects as specified by
+ * PDO_SNOWFLAKE_ATTR_FETCH_VARIANT. Integers that don't fit in zend_long
+ * are decoded to strings.
+ *
+ * The JSON text is decoded in place without copying it to the buffer of
+ * the column.
+ *
+ * @param S Snowflake statement
+ * @param colno The column number to be queried.
+ * @param result Holds the retrieved value.
+ * @return 1 if retrieved or 0 to retrieve the value as a string
+ */
+static int _pdo_snowflake_stmt_get_variant(
+  pdo_snowflake_stmt *S, int colno, zval *result) /* {{{ */
+{
+    const char *raw = NULL;
+    /* integers beyond 2^53 would lose precision as floats */
+    zend_long options = PHP_JSON_BIGINT_AS_STRING;
+
+    snowflake_column_as_const_str(S->stmt, colno + 1, &raw);
+    if (raw == NULL) {
+        return 0;
+    }
+    if (S->options.fetch_variant == PDO_SNOWFLAKE_FETCH_VARIANT_ARRAY) {
+        options |= PHP_JSON_OBJECT_AS_ARRAY;
+    }
+    if (php_json_decode_ex(result, (char *) raw, strlen(raw), options,
+                           PHP_JSON_PARSER_DEFAULT_DEPTH) != SUCCESS) {
+        PDO_LOG_DBG("idx: %d, not a JSON text", colno);
+        zval_ptr_dtor(result);
+        return 0;
+    }
+    return 1;
+}
+/* }}} */
+
+/**
+ * Retrieve a BINARY column as the raw bytes decoded from the hex digits
+ * in the result.
+ *
+ * @param S Snowflake statement
+ * @param colno The column number to be queried.
+ * @param result Holds the retrieved value.
+ * @return 1 if retrieved or 0 to retrieve the value as a string
+ */
+static int _pdo_snowflake_stmt_get_binary(
+  pdo_snowflake_stmt *S, int colno, zval *result) /* {{{ */
+{
+    const char *raw = NULL;
+    zend_string *str;
+    size_t len;
+
+    snowflake_column_as_const_str(S->stmt, colno + 1, &raw);
+    if (raw == NULL) {
+        return 0;
+    }
+    len = strlen(raw);
+    str = zend_string_alloc(len / 2, 0);
+    if (!pdo_sf_hex_decode(raw, len, (unsigned char *) ZSTR_VAL(str))) {
+        PDO_LOG_DBG("idx: %d, not an even number of hex digits", colno);
+        zend_string_efree(str);
+        return 0;
+    }
+    ZSTR_VAL(str)[len / 2] = '\0';
+    ZVAL_NEW_STR(result, str);
+    return 1;
+}
+/* }}} */
+
+/**
+ * Retrieve a TEXT column as a string shared by the cells of the same value.
+ *
+ * The strings of a column are cached by value up to
+ * PDO_SNOWFLAKE_ATTR_INTERN_STRINGS per result, so that the repeated values
+ * of low-cardinality columns don't allocate a string for each row. The
+ * values after the cache is full are allocated as usual.
+ *
+ * @param S Snowflake statement
+ * @param colno The column number to be queried.
+ * @param result Holds the retrieved value.
+ * @return 1 if retrieved or 0 to retrieve the value as a string
+ */
+static int _pdo_snowflake_stmt_get_interned(
+  pdo_snowflake_stmt *S, int colno, zval *result) /* {{{ */
+{
+    const char *raw = NULL;
+    HashTable *ht;
+    zval *cached;
+    zval entry;
+    size_t len;
+
+    snowflake_column_as_const_str(S->stmt, colno + 1, &raw);
+    if (raw == NULL || S->interned == NULL) {
+        return 0;
+    }
+    len = strlen(raw);
+    if (len == 0) {
+        ZVAL_EMPTY_STRING(result);
+        return 1;
+    }
+    ht = S->interned[colno];
+    if (ht == NULL) {
+        ht = emalloc(sizeof(HashTable));
+        zend_hash_init(ht, 8, NULL, ZVAL_PTR_DTOR, 0);
+        S->interned[colno] = ht;
+    }
+    cached = zend_hash_str_find(ht, raw, len);
+    if (cached) {
+        ZVAL_STR_COPY(result, Z_STR_P(cached));
+        return 1;
+    }
+    ZVAL_STRINGL(result, raw, len);
+    if ((zend_long) zend_hash_num_elements(ht) < S->options.intern_strings) {
+        /* the string is the key and the value of the entry */
+        ZVAL_STR_COPY(&entry, Z_STR_P(result));
+        zend_hash_add_new(ht, Z_STR(entry), &entry);
+    }
+    return 1;
+}
+/* }}} */
+
+/**
+ * Retrieve the specified column as a typed value.
+ *
+ * @param S Snowflake statement
+ * @param colno The column number to be queried.
+ * @param type column data type
+ * @param result Holds the retrieved value.
+ * @return 1 if retrieved or 0 to retrieve the value as a string
+ */
+static int _pdo_snowflake_stmt_get_typed(
+  pdo_snowflake_stmt *S, int colno, SF_DB_TYPE type, zval *result) /* {{{ */
+{
+    switch (type) {
+        case SF_DB_TYPE_DATE:
+        case SF_DB_TYPE_TIME:
+        case SF_DB_TYPE_TIMESTAMP_NTZ:
+        case SF_DB_TYPE_TIMESTAMP_LTZ:
+        case SF_DB_TYPE_TIMESTAMP_TZ:
+            return _pdo_snowflake_stmt_get_temporal(S, colno, type, result);
+        case SF_DB_TYPE_FIXED:
+            return _pdo_snowflake_stmt_get_number(
+              S, colno, snowflake_desc(S->stmt)[colno].scale, result);
+        case SF_DB_TYPE_VARIANT:
+        case SF_DB_TYPE_OBJECT:
+        case SF_DB_TYPE_ARRAY:
+            return _pdo_snowflake_stmt_get_variant(S, colno, result);
+        case SF_DB_TYPE_BINARY:
+            return _pdo_snowflake_stmt_get_binary(S, colno, result);
+        case SF_DB_TYPE_TEXT:
+            return _pdo_snowflake_stmt_get_interned(S, colno, result);
+        default:
+            return 0;
+    }
+}
+/* }}} */
+
+/**
+ * Retrieve the specified column as a string.
+ *
+ * TEXT, VARIANT, OBJECT, ARRAY and BINARY values point to the raw value in
+ * the result without copying it. The other values are stored in the buffer
+ * bound to the column. Either string is valid until the next fetch or the
+ * next call for the same column.
  *
  * @param stmt Pointer to the statement structure initialized by handle_preparer.
  * @param colno The column number to be queried.
- * @param ptr Pointer to the retrieved data.
+ * @param ptr Pointer to the retrieved data. NULL if the value is NULL.
  * @param len The length of the data pointed to by ptr.
- * @param caller_frees If set, ptr should point to emalloc'd memory and the
- *        main PDO driver will free it as soon as it is done with it.
- *        Otherwise, it will be the responsibility of the driver to free any
- *        allocated memory as a result of this call.
  * @return 1 if success or 0 if error occurs
  */
-static int
-pdo_snowflake_stmt_get_col(pdo_stmt_t *stmt, int colno, char **ptr, size_t *len,
-                           int *caller_frees) /* {{{ */
+static int _pdo_snowflake_stmt_get_col_str(
+  pdo_stmt_t *stmt, int colno, char **ptr, size_t *len) /* {{{ */
 {
-    PDO_LOG_ENTER("pdo_snowflake_stmt_get_col");
+    PDO_LOG_ENTER("_pdo_snowflake_stmt_get_col_str");
     pdo_snowflake_stmt *S = (pdo_snowflake_stmt *) stmt->driver_data;
     if (colno >= stmt->column_count) {
         /* error invalid column */
         /* TODO */
         PDO_LOG_ERR("ERROR 3");
+        *ptr = NULL;
+        *len = 0;
         PDO_LOG_RETURN(0);
     }
     sf_bool is_null;
@@ -305,9 +888,25 @@ pdo_snowflake_stmt_get_col(pdo_stmt_t *stmt, int colno, char **ptr, size_t *len,
         *len = 0;
     } else {
         size_t value_len = 0;
+        const char *raw = NULL;
         pdo_snowflake_string *str = &(S->bound_results[colno]);
-        snowflake_column_as_str(S->stmt, colno + 1, &str->value, &value_len, &str->size);
-        *ptr = str->value;
+        SF_COLUMN_DESC *F = &snowflake_desc(S->stmt)[colno];
+        if (S->column_formats[colno] == PDO_SNOWFLAKE_FORMAT_RAW) {
+            snowflake_column_as_const_str(S->stmt, colno + 1, &raw);
+            if (raw == NULL) {
+                S->column_formats[colno] = PDO_SNOWFLAKE_FORMAT_CLIENT;
+            }
+        }
+        if (raw) {
+            *ptr = (char *) raw;
+            value_len = strlen(raw);
+        } else {
+            if (S->column_formats[colno] == PDO_SNOWFLAKE_FORMAT_CLIENT ||
+                !_pdo_snowflake_stmt_format_temporal(S, colno, F, str, &value_len)) {
+                snowflake_column_as_str(S->stmt, colno + 1, &str->value, &value_len, &str->size);
+            }
+            *ptr = str->value;
+        }
         *len = value_len;
     }
     PDO_LOG_DBG("idx: %d, value: '%.*s', len: %d", colno, *len, *ptr, *len);
@@ -315,6 +914,96 @@ pdo_snowflake_stmt_get_col(pdo_stmt_t *stmt, int colno, char **ptr, size_t *len,
 }
 /* }}} */
 
+/**
+ * Retrieve the specified column as a zval.
+ *
+ * @param stmt Pointer to the statement structure initialized by handle_preparer.
+ * @param colno The column number to be queried.
+ * @param result Holds the retrieved value.
+ * @return 1 if success or 0 if error occurs
+ */
+static int _pdo_snowflake_stmt_get_col_zval(
+  pdo_stmt_t *stmt, int colno, zval *result) /* {{{ */
+{
+    pdo_snowflake_stmt *S = (pdo_snowflake_stmt *) stmt->driver_data;
+    char *str = NULL;
+    size_t len = 0;
+    int ret;
+
+    if (colno < stmt->column_count) {
+        SF_COLUMN_DESC *F = snowflake_desc(S->stmt);
+        if (_pdo_snowflake_stmt_is_typed_column(S, F[colno].type)) {
+            sf_bool is_null;
+            snowflake_column_is_null(S->stmt, colno + 1, &is_null);
+            if (is_null) {
+                ZVAL_NULL(result);
+                return 1;
+            }
+            if (_pdo_snowflake_stmt_get_typed(S, colno, F[colno].type, result)) {
+                return 1;
+            }
+        }
+    }
+
+    ret = _pdo_snowflake_stmt_get_col_str(stmt, colno, &str, &len);
+    if (len > 0)
+    {
+        ZVAL_STRINGL(result, str, len);
+    }
+    else if (str == NULL)
+    {
+        ZVAL_NULL(result);
+    }
+    else
+    {
+        ZVAL_EMPTY_STRING(result);
+    }
+    return ret;
+}
+/* }}} */
+
+#if (PHP_VERSION_ID < 80100)
+/**
+ * Retrieve data from the specified column.
+ *
+ * The driver should return the result data and length of that data in the
+ * ptr and len variables respectively. It should be noted that the main PDO
+ * driver expects the driver to manage the lifetime of the data. This function
+ * returns 1 for success or 0 in the event of failure.
+ *
+ * The columns fetched as typed values are described as PDO_PARAM_ZVAL and
+ * returned in a zval that the main PDO driver frees.
+ *
+ * @param stmt Pointer to the statement structure initialized by handle_preparer.
+ * @param colno The column number to be queried.
+ * @param ptr Pointer to the retrieved data.
+ * @param len The length of the data pointed to by ptr.
+ * @param caller_frees If set, ptr should point to emalloc'd memory and the
+ *        main PDO driver will free it as soon as it is done with it.
+ *        Otherwise, it will be the responsibility of the driver to free any
+ *        allocated memory as a result of this call.
+ * @return 1 if success or 0 if error occurs
+ */
+static int
+pdo_snowflake_stmt_get_col(pdo_stmt_t *stmt, int colno, char **ptr, size_t *len,
+                           int *caller_frees) /* {{{ */
+{
+    PDO_LOG_ENTER("pdo_snowflake_stmt_get_col");
+    if (colno < stmt->column_count &&
+        stmt->columns[colno].param_type == PDO_PARAM_ZVAL) {
+        zval *value = emalloc(sizeof(zval));
+        int ret = _pdo_snowflake_stmt_get_col_zval(stmt, colno, value);
+        *ptr = (char *) value;
+        *len = sizeof(zval);
+        *caller_frees = 1;
+        PDO_LOG_RETURN(ret);
+    }
+    int ret = _pdo_snowflake_stmt_get_col_str(stmt, colno, ptr, len);
+    PDO_LOG_RETURN(ret);
+}
+/* }}} */
+#endif
+
 /**
  * Bind parameters or columns.
  *
@@ -629,20 +1318,91 @@ static int pdo_snowflake_stmt_next_rowset(pdo_stmt_t *stmt) /* {{{ */
  * that you are done with a given rowset, without having to explicitly
  * fetch all the rows.
  *
+ * Unlike other database, Snowflake doesn't need to fetch all data to close
+ * the statement, but the chunk downloader of the client keeps downloading
+ * the rest of the result until the statement is reset. Preparing the
+ * statement again stops the downloader and releases the chunks right away.
+ *
  * @param stmt Pointer to the statement structure initialized by handle_preparer.
  * @return 1 if success or 0 if error occurs
  */
 static int pdo_snowflake_stmt_cursor_closer(pdo_stmt_t *stmt) /* {{{ */
 {
+    pdo_snowflake_stmt *S = (pdo_snowflake_stmt *) stmt->driver_data;
+    SF_STATUS status;
     PDO_LOG_ENTER("pdo_snowflake_stmt_cursor_closer");
-    /* NOP. unlike other database, Snowflake doesn't need to fetch
-     * all data to close the statement.
-     * */
+
+    _pdo_snowflake_stmt_free_bound_results(stmt);
+    S->timezone_loaded = 0;
+    S->row_position = 0;
+    /* the client releases its copy of the SQL before copying the new one,
+     * so the SQL is taken from PDO */
+#if (PHP_VERSION_ID >= 80100)
+    status = snowflake_prepare(S->stmt, ZSTR_VAL(stmt->query_string),
+                               ZSTR_LEN(stmt->query_string));
+#else
+    status = snowflake_prepare(S->stmt, stmt->query_string,
+                               stmt->query_stringlen);
+#endif
+    if (status != SF_STATUS_SUCCESS) {
+        pdo_snowflake_error_stmt(stmt);
+        PDO_LOG_RETURN(0);
+    }
     PDO_LOG_RETURN(1);
 }
 
 /* }}} */
 
+/**
+ * Set a statement attribute.
+ *
+ * @param stmt Pointer to the statement structure initialized by handle_preparer.
+ * @param attr The attribute to be set.
+ * @param val The value of the attribute.
+ * @return 1 if success or 0 if error occurs
+ */
+static int pdo_snowflake_stmt_set_attr(
+  pdo_stmt_t *stmt, zend_long attr, zval *val) /* {{{ */
+{
+    pdo_snowflake_stmt *S = (pdo_snowflake_stmt *) stmt->driver_data;
+    PDO_LOG_ENTER("pdo_snowflake_stmt_set_attr");
+    PDO_LOG_DBG("attr=%ld", attr);
+    switch (attr) {
+        case PDO_SNOWFLAKE_ATTR_DESCRIBE_ONLY:
+            S->describe_only = zval_is_true(val) ? 1 : 0;
+            PDO_LOG_RETURN(1);
+        default:
+            PDO_LOG_DBG("unsupported attribute: %ld", attr);
+            PDO_LOG_RETURN(0);
+    }
+}
+/* }}} */
+
+/**
+ * Get a statement attribute.
+ *
+ * @param stmt Pointer to the statement structure initialized by handle_preparer.
+ * @param attr The attribute to be retrieved.
+ * @param return_value Holds the value of the attribute.
+ * @return 1 if success or 0 if the attribute is not supported
+ */
+static int pdo_snowflake_stmt_get_attr(
+  pdo_stmt_t *stmt, zend_long attr, zval *return_value) /* {{{ */
+{
+    pdo_snowflake_stmt *S = (pdo_snowflake_stmt *) stmt->driver_data;
+    PDO_LOG_ENTER("pdo_snowflake_stmt_get_attr");
+    PDO_LOG_DBG("attr=%ld", attr);
+    switch (attr) {
+        case PDO_SNOWFLAKE_ATTR_DESCRIBE_ONLY:
+            ZVAL_BOOL(return_value, S->describe_only);
+            PDO_LOG_RETURN(1);
+        default:
+            PDO_LOG_DBG("unsupported attribute: %ld", attr);
+            PDO_LOG_RETURN(0);
+    }
+}
+/* }}} */
+
 #if (PHP_VERSION_ID < 80100)
 struct pdo_stmt_methods snowflake_stmt_methods = {
   pdo_snowflake_stmt_dtor,
@@ -651,8 +1411,8 @@ struct pdo_stmt_methods snowflake_stmt_methods = {
   pdo_snowflake_stmt_describe,
   pdo_snowflake_stmt_get_col,
   pdo_snowflake_stmt_param_hook,
-  NULL, /* set_attr */
-  NULL, /* get_attr */
+  pdo_snowflake_stmt_set_attr,
+  pdo_snowflake_stmt_get_attr,
   pdo_snowflake_stmt_col_meta,
   pdo_snowflake_stmt_next_rowset,
   pdo_snowflake_stmt_cursor_closer
@@ -661,22 +1421,7 @@ struct pdo_stmt_methods snowflake_stmt_methods = {
 static int pdo_snowflake_stmt_get_col_newif(
     pdo_stmt_t *stmt, int colno, zval *result, enum pdo_param_type *type)
 {
-    char* str = NULL;
-    size_t len = 0;
-    int ret = pdo_snowflake_stmt_get_col(stmt, colno, &str, &len, NULL);
-    if (len > 0)
-    {
-        ZVAL_STRINGL(result, str, len);
-    }
-    else if (str == NULL)
-    {
-        ZVAL_NULL(result);
-    }
-    else
-    {
-        ZVAL_EMPTY_STRING(result);
-    }
-    return ret;
+    return _pdo_snowflake_stmt_get_col_zval(stmt, colno, result);
 }
 struct pdo_stmt_methods snowflake_stmt_methods = {
   pdo_snowflake_stmt_dtor,
@@ -685,8 +1430,8 @@ struct pdo_stmt_methods snowflake_stmt_methods = {
   pdo_snowflake_stmt_describe,
   pdo_snowflake_stmt_get_col_newif,
   pdo_snowflake_stmt_param_hook,
-  NULL, /* set_attr */
-  NULL, /* get_attr */
+  pdo_snowflake_stmt_set_attr,
+  pdo_snowflake_stmt_get_attr,
   pdo_snowflake_stmt_col_meta,
   pdo_snowflake_stmt_next_rowset,
   pdo_snowflake_stmt_cursor_closer
@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2017-2019 Snowflake Computing, Inc. All rights reserved.
+ */
+
+#include "php.h"
+#include "ext/date/php_date.h"
+#include "snowflake_temporal.h"
+
+#define SECONDS_PER_DAY 86400
+#define NANOSECONDS_PER_SECOND 1000000000
+/* 12 digits cover the epoch seconds of 9999-12-31 */
+#define MAX_INTEGER_DIGITS 12
+#define MAX_FRACTION_DIGITS 9
+
+/**
+ * Days since the epoch of a proleptic Gregorian calendar date.
+ *
+ * @param y year
+ * @param m month, 1..12
+ * @param d day of month, 1..31
+ * @return the number of days since 1970-01-01
+ */
+static int64 days_from_civil(int64 y, int m, int d) {
+    int64 era;
+    int64 yoe;
+    int64 doy;
+    int64 doe;
+
+    y -= m <= 2;
+    era = (y >= 0 ? y : y - 399) / 400;
+    yoe = y - era * 400;
+    doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+/**
+ * Proleptic Gregorian calendar date of a day since the epoch.
+ *
+ * @param z the number of days since 1970-01-01
+ * @param y year
+ * @param m month, 1..12
+ * @param d day of month, 1..31
+ */
+static void civil_from_days(int64 z, int64 *y, int *m, int *d) {
+    int64 era;
+    int64 doe;
+    int64 yoe;
+    int64 doy;
+    int64 mp;
+
+    z += 719468;
+    era = (z >= 0 ? z : z - 146096) / 146097;
+    doe = z - era * 146097;
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    mp = (5 * doy + 2) / 153;
+    *d = (int) (doy - (153 * mp + 2) / 5 + 1);
+    *m = (int) (mp < 10 ? mp + 3 : mp - 9);
+    *y = yoe + era * 400 + (*m <= 2);
+}
+
+/**
+ * Write a zero padded decimal number.
+ *
+ * @param p buffer
+ * @param v non-negative number
+ * @param width the number of digits
+ * @return pointer to the character after the number
+ */
+static char *put_digits(char *p, int32 v, int width) {
+    int i;
+
+    for (i = width - 1; i >= 0; i--) {
+        p[i] = (char) ('0' + v % 10);
+        v /= 10;
+    }
+    return p + width;
+}
+
+/**
+ * Parse a decimal number of seconds in the form of [-]digits[.digits].
+ *
+ * The value is normalized so that nsec is never negative, e.g., -1.25
+ * becomes sec = -2 and nsec = 750000000.
+ *
+ * @param p pointer to the string. Advanced to the first character
+ * after the number.
+ * @param sec integer part
+ * @param nsec fraction part in nanoseconds
+ * @return SF_BOOLEAN_TRUE if parsed or SF_BOOLEAN_FALSE otherwise
+ */
+static sf_bool parse_seconds(const char **p, int64 *sec, int32 *nsec) {
+    const char *c = *p;
+    sf_bool negative = SF_BOOLEAN_FALSE;
+    int64 integer = 0;
+    int32 fraction = 0;
+    int digits;
+
+    if (*c == '-') {
+        negative = SF_BOOLEAN_TRUE;
+        c++;
+    }
+    for (digits = 0; *c >= '0' && *c <= '9'; c++, digits++) {
+        if (digits == MAX_INTEGER_DIGITS) {
+            return SF_BOOLEAN_FALSE;
+        }
+        integer = integer * 10 + (*c - '0');
+    }
+    if (digits == 0) {
+        return SF_BOOLEAN_FALSE;
+    }
+    if (*c == '.') {
+        c++;
+        for (digits = 0; *c >= '0' && *c <= '9'; c++, digits++) {
+            if (digits == MAX_FRACTION_DIGITS) {
+                return SF_BOOLEAN_FALSE;
+            }
+            fraction = fraction * 10 + (*c - '0');
+        }
+        if (digits == 0) {
+            return SF_BOOLEAN_FALSE;
+        }
+        for (; digits < MAX_FRACTION_DIGITS; digits++) {
+            fraction *= 10;
+        }
+    }
+    if (negative) {
+        integer = -integer;
+        if (fraction > 0) {
+            integer--;
+            fraction = NANOSECONDS_PER_SECOND - fraction;
+        }
+    }
+    *p = c;
+    *sec = integer;
+    *nsec = fraction;
+    return SF_BOOLEAN_TRUE;
+}
+
+/**
+ * Decode the raw value of a DATE, TIME or TIMESTAMP cell in a JSON
+ * result, i.e., days since the epoch for DATE, seconds since midnight
+ * for TIME, seconds since the epoch for TIMESTAMP and the seconds
+ * followed by the offset in minutes plus 1440 for TIMESTAMP_TZ.
+ *
+ * @param type column data type
+ * @param raw the raw value
+ * @param value decoded value
+ * @return SF_BOOLEAN_TRUE if decoded or SF_BOOLEAN_FALSE if the value is
+ * not in the raw format, e.g., an Arrow result.
+ */
+sf_bool STDCALL pdo_sf_temporal_from_raw(SF_DB_TYPE type, const char *raw,
+                                         PDO_SF_TEMPORAL *value) {
+    const char *p = raw;
+    int32 offset = 0;
+    int digits;
+
+    if (!parse_seconds(&p, &value->sec, &value->nsec)) {
+        return SF_BOOLEAN_FALSE;
+    }
+    value->tzoffset = 0;
+    switch (type) {
+        case SF_DB_TYPE_DATE:
+            if (value->nsec != 0) {
+                return SF_BOOLEAN_FALSE;
+            }
+            value->sec *= SECONDS_PER_DAY;
+            break;
+        case SF_DB_TYPE_TIMESTAMP_TZ:
+            if (*p++ != ' ') {
+                return SF_BOOLEAN_FALSE;
+            }
+            for (digits = 0; *p >= '0' && *p <= '9'; p++, digits++) {
+                if (digits == 4) {
+                    return SF_BOOLEAN_FALSE;
+                }
+                offset = offset * 10 + (*p - '0');
+            }
+            if (digits == 0) {
+                return SF_BOOLEAN_FALSE;
+            }
+            value->tzoffset = offset - 1440;
+            break;
+        case SF_DB_TYPE_TIME:
+        case SF_DB_TYPE_TIMESTAMP_NTZ:
+        case SF_DB_TYPE_TIMESTAMP_LTZ:
+            break;
+        default:
+            return SF_BOOLEAN_FALSE;
+    }
+    return *p == '\0' ? SF_BOOLEAN_TRUE : SF_BOOLEAN_FALSE;
+}
+
+/**
+ * Decode a DATE, TIME or TIMESTAMP value converted by the client.
+ *
+ * @param type column data type
+ * @param ts timestamp converted by snowflake_column_as_timestamp
+ * @param value decoded value
+ */
+void STDCALL pdo_sf_temporal_from_timestamp(SF_DB_TYPE type,
+                                            const SF_TIMESTAMP *ts,
+                                            PDO_SF_TEMPORAL *value) {
+    int64 days = 0;
+
+    if (type != SF_DB_TYPE_TIME) {
+        days = days_from_civil((int64) ts->tm_obj.tm_year + 1900,
+                               ts->tm_obj.tm_mon + 1, ts->tm_obj.tm_mday);
+    }
+    value->sec = days * SECONDS_PER_DAY + ts->tm_obj.tm_hour * 3600 +
+                 ts->tm_obj.tm_min * 60 + ts->tm_obj.tm_sec;
+    value->nsec = ts->nsec;
+    value->tzoffset = 0;
+    if (type == SF_DB_TYPE_TIMESTAMP_LTZ || type == SF_DB_TYPE_TIMESTAMP_TZ) {
+        /* tm_obj has the local time */
+        value->tzoffset = ts->tzoffset;
+        value->sec -= (int64) ts->tzoffset * 60;
+    }
+}
+
+/**
+ * Set the seconds since the epoch, or since midnight for TIME. The
+ * fraction of the second is truncated toward the past.
+ *
+ * @param value decoded value
+ * @param result zval to store the integer
+ */
+void STDCALL pdo_sf_temporal_to_epoch_seconds(const PDO_SF_TEMPORAL *value,
+                                              zval *result) {
+    char buf[32];
+
+    if (value->sec >= ZEND_LONG_MIN && value->sec <= ZEND_LONG_MAX) {
+        ZVAL_LONG(result, (zend_long) value->sec);
+        return;
+    }
+    /* out of range of the PHP integer */
+    ZVAL_STRINGL(result, buf,
+                 snprintf(buf, sizeof(buf), "%lld", (long long) value->sec));
+}
+
+/**
+ * Set the nanoseconds since the epoch, or since midnight for TIME. The
+ * value is set as a numeric string if it is out of range of the PHP
+ * integer.
+ *
+ * @param value decoded value
+ * @param result zval to store the integer
+ */
+void STDCALL pdo_sf_temporal_to_epoch_nanoseconds(const PDO_SF_TEMPORAL *value,
+                                                  zval *result) {
+    char buf[32];
+    int64 sec = value->sec;
+    int32 nsec = value->nsec;
+    const char *sign = "";
+
+    if (sec > -(INT64_MAX / NANOSECONDS_PER_SECOND) &&
+        sec < INT64_MAX / NANOSECONDS_PER_SECOND) {
+        int64 ns = sec * NANOSECONDS_PER_SECOND + nsec;
+        if (ns >= ZEND_LONG_MIN && ns <= ZEND_LONG_MAX) {
+            ZVAL_LONG(result, (zend_long) ns);
+            return;
+        }
+    }
+    /* out of range of the PHP integer */
+    if (sec < 0) {
+        sign = "-";
+        if (nsec > 0) {
+            sec++;
+            nsec = NANOSECONDS_PER_SECOND - nsec;
+        }
+        sec = -sec;
+    }
+    if (sec == 0) {
+        ZVAL_STRINGL(result, buf,
+                     snprintf(buf, sizeof(buf), "%s%d", sign, (int) nsec));
+    } else {
+        ZVAL_STRINGL(result, buf,
+                     snprintf(buf, sizeof(buf), "%s%lld%09d", sign,
+                              (long long) sec, (int) nsec));
+    }
+}
+
+/**
+ * Set a DateTimeImmutable object with the time zone offset of the value.
+ * DATE and TIMESTAMP_NTZ values are in +00:00. The fraction of the second
+ * is truncated to microseconds.
+ *
+ * @param value decoded value
+ * @param result zval to store the object
+ */
+void STDCALL pdo_sf_temporal_to_datetime(const PDO_SF_TEMPORAL *value,
+                                         zval *result) {
+    php_date_obj *dateobj;
+    timelib_time *t;
+
+    php_date_instantiate(php_date_get_immutable_ce(), result);
+    dateobj = Z_PHPDATE_P(result);
+
+    t = timelib_time_ctor();
+    t->zone_type = TIMELIB_ZONETYPE_OFFSET;
+    t->z = value->tzoffset * 60;
+    t->dst = 0;
+    timelib_unixtime2local(t, (timelib_sll) value->sec);
+    t->us = value->nsec / 1000;
+    dateobj->time = t;
+}
+
+/**
+ * Format a DATE, TIME or TIMESTAMP value in the same way as
+ * snowflake_column_as_str, i.e., YYYY-MM-DD for DATE, HH24:MI:SS for TIME
+ * and YYYY-MM-DD HH24:MI:SS for TIMESTAMP. TIME and TIMESTAMP are followed
+ * by the fraction of the second if the scale is not 0, and TIMESTAMP_TZ by
+ * the offset.
+ *
+ * @param type column data type
+ * @param value decoded value
+ * @param gmtoff seconds east of UTC of the local time
+ * @param scale the number of digits of the fraction
+ * @param buf buffer of PDO_SF_TEMPORAL_STR_SIZE bytes
+ * @return the length of the string or 0 if the value must be formatted by
+ * the client.
+ */
+size_t STDCALL pdo_sf_temporal_to_str(SF_DB_TYPE type,
+                                      const PDO_SF_TEMPORAL *value,
+                                      int32 gmtoff, int64 scale, char *buf) {
+    static const int32 pow10[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+        1000000000
+    };
+    char *p = buf;
+    int64 local;
+    int64 days;
+    int32 secs;
+    int64 year;
+    int month;
+    int day;
+    int32 offset;
+
+    if (scale < 0 || scale > MAX_FRACTION_DIGITS) {
+        return 0;
+    }
+    switch (type) {
+        case SF_DB_TYPE_DATE:
+            scale = 0;
+            break;
+        case SF_DB_TYPE_TIME:
+            if (value->sec < 0 || value->sec >= SECONDS_PER_DAY) {
+                return 0;
+            }
+            break;
+        case SF_DB_TYPE_TIMESTAMP_TZ:
+            if (value->tzoffset > 0 && value->tzoffset < 60) {
+                /* The client formats +00:MM as -00:MM */
+                return 0;
+            }
+            /* fall through */
+        case SF_DB_TYPE_TIMESTAMP_NTZ:
+        case SF_DB_TYPE_TIMESTAMP_LTZ:
+            if (value->sec == -1 && value->nsec > 0) {
+                /* The client takes the integer part of -0.x as 0 */
+                return 0;
+            }
+            break;
+        default:
+            return 0;
+    }
+
+    local = value->sec + gmtoff;
+    days = local / SECONDS_PER_DAY;
+    secs = (int32) (local % SECONDS_PER_DAY);
+    if (secs < 0) {
+        days--;
+        secs += SECONDS_PER_DAY;
+    }
+    if (type != SF_DB_TYPE_TIME) {
+        civil_from_days(days, &year, &month, &day);
+        if (year < 1000 || year > 9999) {
+            /* strftime does not pad the year to 4 digits on all platforms */
+            return 0;
+        }
+        p = put_digits(p, (int32) year, 4);
+        *p++ = '-';
+        p = put_digits(p, month, 2);
+        *p++ = '-';
+        p = put_digits(p, day, 2);
+        if (type == SF_DB_TYPE_DATE) {
+            *p = '\0';
+            return (size_t) (p - buf);
+        }
+        *p++ = ' ';
+    }
+    p = put_digits(p, secs / 3600, 2);
+    *p++ = ':';
+    p = put_digits(p, secs / 60 % 60, 2);
+    *p++ = ':';
+    p = put_digits(p, secs % 60, 2);
+    if (scale > 0) {
+        *p++ = '.';
+        p = put_digits(p, value->nsec / pow10[MAX_FRACTION_DIGITS - scale],
+                       (int) scale);
+    }
+    if (type == SF_DB_TYPE_TIMESTAMP_TZ) {
+        /* The sign follows the hours as the client does */
+        offset = value->tzoffset;
+        *p++ = ' ';
+        *p++ = offset / 60 > 0 ? '+' : '-';
+        if (offset < 0) {
+            offset = -offset;
+        }
+        p = put_digits(p, offset / 60, 2);
+        *p++ = ':';
+        p = put_digits(p, offset % 60, 2);
+    }
+    *p = '\0';
+    return (size_t) (p - buf);
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2017-2019 Snowflake Computing, Inc. All rights reserved.
+ */
+
+#ifndef PHP_PDO_SNOWFLAKE_TEMPORAL_H
+#define PHP_PDO_SNOWFLAKE_TEMPORAL_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+#if !defined(_WIN32)
+#define STDCALL
+#else
+#define STDCALL __stdcall
+#endif
+
+#include "php.h"
+#include <snowflake/client.h>
+
+/**
+ * DATE, TIME and TIMESTAMP value decoded from a result cell.
+ */
+typedef struct pdo_sf_temporal {
+    /* seconds since the epoch, or since midnight for TIME */
+    int64 sec;
+    /* nanoseconds in the second, always 0..999999999 */
+    int32 nsec;
+    /* time zone offset in minutes, TIMESTAMP_LTZ and TIMESTAMP_TZ only */
+    int32 tzoffset;
+} PDO_SF_TEMPORAL;
+
+/**
+ * Buffer size of a formatted value
+ */
+#define PDO_SF_TEMPORAL_STR_SIZE 64
+
+sf_bool STDCALL pdo_sf_temporal_from_raw(SF_DB_TYPE type, const char *raw,
+                                         PDO_SF_TEMPORAL *value);
+void STDCALL pdo_sf_temporal_from_timestamp(SF_DB_TYPE type,
+                                            const SF_TIMESTAMP *ts,
+                                            PDO_SF_TEMPORAL *value);
+void STDCALL pdo_sf_temporal_to_epoch_seconds(const PDO_SF_TEMPORAL *value,
+                                              zval *result);
+void STDCALL pdo_sf_temporal_to_epoch_nanoseconds(const PDO_SF_TEMPORAL *value,
+                                                  zval *result);
+void STDCALL pdo_sf_temporal_to_datetime(const PDO_SF_TEMPORAL *value,
+                                         zval *result);
+size_t STDCALL pdo_sf_temporal_to_str(SF_DB_TYPE type,
+                                      const PDO_SF_TEMPORAL *value,
+                                      int32 gmtoff, int64 scale, char *buf);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif //PHP_PDO_SNOWFLAKE_TEMPORAL_H
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) 2017-2019 Snowflake Computing, Inc. All rights reserved.
+ */
+
+#include "php.h"
+#include "Zend/zend_exceptions.h"
+#include "ext/date/php_date.h"
+#include "snowflake_timezone.h"
+
+#if SIZEOF_ZEND_LONG == 4
+#define TRANSITIONS_BEGIN ZEND_LONG_MIN
+#define TRANSITIONS_END ZEND_LONG_MAX
+#else
+/* 1900-01-01 00:00:00 UTC */
+#define TRANSITIONS_BEGIN ((zend_long) -2208988800LL)
+/* 2100-01-01 00:00:00 UTC */
+#define TRANSITIONS_END ((zend_long) 4102444800LL)
+#endif
+/*
+ * 2037-01-01 00:00:00 UTC. Older time zone databases list the daylight
+ * saving time transitions up to 2037 only.
+ */
+#define DST_RULES_HORIZON 2114380800LL
+
+/**
+ * Call a method of an object.
+ *
+ * @param object object
+ * @param name method name
+ * @param retval return value. Must be destroyed by the caller on success.
+ * @param argc the number of arguments
+ * @param argv arguments
+ * @return SF_BOOLEAN_TRUE if called or SF_BOOLEAN_FALSE if failed or
+ * an exception was thrown. The exception is cleared.
+ */
+static sf_bool call_method(zval *object, const char *name, zval *retval,
+                           uint32_t argc, zval *argv) {
+    zval function_name;
+    int ret;
+
+    ZVAL_STRING(&function_name, name);
+    ret = call_user_function(NULL, object, &function_name, retval, argc, argv);
+    zval_ptr_dtor(&function_name);
+    if (EG(exception)) {
+        zend_clear_exception();
+        if (ret == SUCCESS) {
+            zval_ptr_dtor(retval);
+        }
+        return SF_BOOLEAN_FALSE;
+    }
+    return ret == SUCCESS ? SF_BOOLEAN_TRUE : SF_BOOLEAN_FALSE;
+}
+
+/**
+ * Build the offset rules of a time zone from the time zone database
+ * bundled with PHP, i.e., DateTimeZone::getTransitions.
+ *
+ * @param name time zone name, e.g., America/Los_Angeles
+ * @return the offset rules allocated in the persistent memory or NULL if
+ * the time zone is unknown.
+ */
+static PDO_SF_TIMEZONE *timezone_load(const char *name) {
+    PDO_SF_TIMEZONE *tz = NULL;
+    zval object;
+    zval retval;
+    zval args[2];
+    zval *transition;
+    zval *ts;
+    zval *offset;
+    size_t count;
+
+    object_init_ex(&object, php_date_get_timezone_ce());
+    ZVAL_STRING(&args[0], name);
+    if (!call_method(&object, "__construct", &retval, 1, args)) {
+        zval_ptr_dtor(&args[0]);
+        zval_ptr_dtor(&object);
+        return NULL;
+    }
+    zval_ptr_dtor(&retval);
+    zval_ptr_dtor(&args[0]);
+
+    ZVAL_LONG(&args[0], TRANSITIONS_BEGIN);
+    ZVAL_LONG(&args[1], TRANSITIONS_END);
+    if (!call_method(&object, "getTransitions", &retval, 2, args)) {
+        zval_ptr_dtor(&object);
+        return NULL;
+    }
+    zval_ptr_dtor(&object);
+    if (Z_TYPE(retval) != IS_ARRAY ||
+        zend_hash_num_elements(Z_ARRVAL(retval)) == 0) {
+        /* e.g., a fixed offset such as +09:00 has no transitions */
+        zval_ptr_dtor(&retval);
+        return NULL;
+    }
+
+    count = zend_hash_num_elements(Z_ARRVAL(retval));
+    tz = pemalloc(sizeof(PDO_SF_TIMEZONE) +
+                  count * (sizeof(int64) + sizeof(int32)), 1);
+    tz->times = (int64 *) (tz + 1);
+    tz->offsets = (int32 *) (tz->times + count);
+    tz->count = 0;
+    ZEND_HASH_FOREACH_VAL(Z_ARRVAL(retval), transition) {
+        if (Z_TYPE_P(transition) != IS_ARRAY) {
+            goto error;
+        }
+        ts = zend_hash_str_find(Z_ARRVAL_P(transition), ZEND_STRL("ts"));
+        offset = zend_hash_str_find(Z_ARRVAL_P(transition),
+                                    ZEND_STRL("offset"));
+        if (ts == NULL || Z_TYPE_P(ts) != IS_LONG ||
+            offset == NULL || Z_TYPE_P(offset) != IS_LONG) {
+            goto error;
+        }
+        if (tz->count > 0 && tz->times[tz->count - 1] >= Z_LVAL_P(ts)) {
+            if (tz->times[tz->count - 1] > Z_LVAL_P(ts)) {
+                /* not sorted */
+                goto error;
+            }
+            /* the transition at the beginning of the range */
+            tz->count--;
+        }
+        tz->times[tz->count] = (int64) Z_LVAL_P(ts);
+        tz->offsets[tz->count] = (int32) Z_LVAL_P(offset);
+        tz->count++;
+    } ZEND_HASH_FOREACH_END();
+    zval_ptr_dtor(&retval);
+
+    if (tz->times[tz->count - 1] >= DST_RULES_HORIZON) {
+        /* later transitions may not be listed */
+        tz->limit = tz->times[tz->count - 1];
+    } else {
+        /* no more changes are scheduled */
+        tz->limit = (int64) TRANSITIONS_END;
+    }
+    return tz;
+
+error:
+    zval_ptr_dtor(&retval);
+    pefree(tz, 1);
+    return NULL;
+}
+
+/**
+ * Destructor of the time zone cache entries
+ *
+ * @param zv cache entry
+ */
+static void timezone_dtor(zval *zv) {
+    if (Z_PTR_P(zv) != NULL) {
+        pefree(Z_PTR_P(zv), 1);
+    }
+}
+
+/**
+ * Find the offset rules of a time zone. The rules are built once and
+ * cached, so that no process wide time zone, i.e., the TZ environment
+ * variable, is used to convert the values.
+ *
+ * The cache is not shared by threads.
+ *
+ * @param cache time zone cache. Allocated in the persistent memory at the
+ * first call.
+ * @param name time zone name
+ * @return the offset rules or NULL if the time zone is unknown
+ */
+const PDO_SF_TIMEZONE *STDCALL pdo_sf_timezone_find(HashTable **cache,
+                                                    const char *name) {
+    PDO_SF_TIMEZONE *tz;
+    zval *entry;
+    size_t len;
+
+    if (name == NULL || *name == '\0') {
+        return NULL;
+    }
+    len = strlen(name);
+    if (*cache == NULL) {
+        *cache = pemalloc(sizeof(HashTable), 1);
+        zend_hash_init(*cache, 8, NULL, timezone_dtor, 1);
+    } else if ((entry = zend_hash_str_find(*cache, name, len)) != NULL) {
+        return Z_PTR_P(entry);
+    }
+    /* unknown time zones are cached as well */
+    tz = timezone_load(name);
+    zend_hash_str_update_ptr(*cache, name, len, tz);
+    return tz;
+}
+
+/**
+ * Get the UTC offset in effect at a time.
+ *
+ * @param tz offset rules
+ * @param sec seconds since the epoch
+ * @param gmtoff seconds east of UTC
+ * @return SF_BOOLEAN_TRUE if found or SF_BOOLEAN_FALSE if the time is out
+ * of range of the rules.
+ */
+sf_bool STDCALL pdo_sf_timezone_offset(const PDO_SF_TIMEZONE *tz, int64 sec,
+                                       int32 *gmtoff) {
+    size_t low = 0;
+    size_t high;
+    size_t mid;
+
+    if (sec < tz->times[0] || sec >= tz->limit) {
+        return SF_BOOLEAN_FALSE;
+    }
+    /* the last transition at or before sec */
+    high = tz->count;
+    while (high - low > 1) {
+        mid = low + (high - low) / 2;
+        if (tz->times[mid] <= sec) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    *gmtoff = tz->offsets[low];
+    return SF_BOOLEAN_TRUE;
+}
+
+/**
+ * Free the time zone cache.
+ *
+ * @param cache time zone cache
+ */
+void STDCALL pdo_sf_timezone_cache_destroy(HashTable **cache) {
+    if (*cache != NULL) {
+        zend_hash_destroy(*cache);
+        pefree(*cache, 1);
+        *cache = NULL;
+    }
+}
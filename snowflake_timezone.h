@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2017-2019 Snowflake Computing, Inc. All rights reserved.
+ */
+
+#ifndef PHP_PDO_SNOWFLAKE_TIMEZONE_H
+#define PHP_PDO_SNOWFLAKE_TIMEZONE_H
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+#if !defined(_WIN32)
+#define STDCALL
+#else
+#define STDCALL __stdcall
+#endif
+
+#include "php.h"
+#include <snowflake/client.h>
+
+/**
+ * UTC offset rules of a time zone, i.e., the sorted list of the
+ * transition times and the offset in effect from each of them.
+ */
+typedef struct pdo_sf_timezone {
+    /* the offsets are known in [times[0], limit) */
+    int64 limit;
+    size_t count;
+    int64 *times;
+    /* seconds east of UTC */
+    int32 *offsets;
+} PDO_SF_TIMEZONE;
+
+const PDO_SF_TIMEZONE *STDCALL pdo_sf_timezone_find(HashTable **cache,
+                                                    const char *name);
+sf_bool STDCALL pdo_sf_timezone_offset(const PDO_SF_TIMEZONE *tz, int64 sec,
+                                       int32 *gmtoff);
+void STDCALL pdo_sf_timezone_cache_destroy(HashTable **cache);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif //PHP_PDO_SNOWFLAKE_TIMEZONE_H
@@ -0,0 +1,37 @@
+--TEST--
+pdo_snowflake - memory of the client outside of memory_limit
+--INI--
+pdo_snowflake.cacert=libsnowflakeclient/cacert.pem
+memory_limit=16M
+--FILE--
+<?php
+    include __DIR__ . "/common.php";
+
+    $dbh = new PDO($dsn, $user, $password);
+    $dbh->setAttribute( PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION );
+    echo "Connected to Snowflake\n";
+
+    /* the result is larger than memory_limit, but each row is small */
+    $count = 0;
+    $len = 0;
+    $sth = $dbh->query("select seq8(), randstr(1000, random()) from table(generator(rowcount=>50000))");
+    while ($row = $sth->fetch(PDO::FETCH_NUM)) {
+        $count++;
+        $len += strlen($row[1]);
+    }
+    echo sprintf("rows: %d, bytes: %d\n", $count, $len);
+
+    ob_start();
+    phpinfo(INFO_MODULES);
+    $info = ob_get_clean();
+    echo preg_match("/Client memory peak usage => [1-9][0-9]*/", $info) ? "reported\n" : "not reported\n";
+
+    $dbh = null;
+?>
+===DONE===
+<?php exit(0); ?>
+--EXPECT--
+Connected to Snowflake
+rows: 50000, bytes: 50000000
+reported
+===DONE===
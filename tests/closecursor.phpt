@@ -0,0 +1,48 @@
+--TEST--
+pdo_snowflake - close the cursor of a large result and execute again
+--INI--
+pdo_snowflake.cacert=libsnowflakeclient/cacert.pem
+--FILE--
+<?php
+    include __DIR__ . "/common.php";
+
+    $dbh = new PDO($dsn, $user, $password);
+    $dbh->setAttribute( PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION );
+    echo "Connected to Snowflake\n";
+
+    /* many chunks to download */
+    $sth = $dbh->prepare("select seq8() + ?, randstr(1000, random()) " .
+        "from table(generator(rowcount=>100000)) order by 1");
+    $sth->bindValue(1, 1, PDO::PARAM_INT);
+    $sth->execute();
+    $row = $sth->fetch(PDO::FETCH_NUM);
+    echo sprintf("first: %d\n", $row[0]);
+    var_dump($sth->closeCursor());
+
+    /* the statement is still prepared */
+    $sth->bindValue(1, 100, PDO::PARAM_INT);
+    $sth->execute();
+    $row = $sth->fetch(PDO::FETCH_NUM);
+    echo sprintf("first: %d\n", $row[0]);
+    var_dump($sth->closeCursor());
+
+    $sth->execute();
+    $count = 0;
+    while ($row = $sth->fetch(PDO::FETCH_NUM)) {
+        $count++;
+    }
+    echo sprintf("rows: %d, last: %d\n", $count, $row === false ? -1 : $row[0]);
+
+    $sth = null;
+    $dbh = null;
+?>
+===DONE===
+<?php exit(0); ?>
+--EXPECT--
+Connected to Snowflake
+first: 1
+bool(true)
+first: 100
+bool(true)
+rows: 100000, last: -1
+===DONE===
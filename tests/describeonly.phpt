@@ -0,0 +1,45 @@
+--TEST--
+pdo_snowflake - describe a query without running it
+--INI--
+pdo_snowflake.cacert=libsnowflakeclient/cacert.pem
+--FILE--
+<?php
+    include __DIR__ . "/common.php";
+
+    $dbh = new PDO($dsn, $user, $password);
+    $dbh->setAttribute( PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION );
+    echo "Connected to Snowflake\n";
+
+    $sth = $dbh->prepare(
+        "select 1::number(10,2) as c1, 'test'::varchar(10) as c2, '2021-01-01'::date as c3",
+        array(PDO::SNOWFLAKE_ATTR_DESCRIBE_ONLY => true));
+    echo sprintf("describe only: %s\n", var_export($sth->getAttribute(PDO::SNOWFLAKE_ATTR_DESCRIBE_ONLY), true));
+    $sth->execute();
+    echo sprintf("column count: %d\n", $sth->columnCount());
+    for ($i = 0; $i < $sth->columnCount(); $i++) {
+        $meta = $sth->getColumnMeta($i);
+        echo sprintf("name: %s, native_type: %s, scale: %s, precision: %s\n", $meta["name"], $meta["native_type"], $meta["scale"], $meta["precision"]);
+    }
+    echo sprintf("row: %s\n", var_export($sth->fetch(PDO::FETCH_NUM), true));
+
+    /* run the same statement */
+    $sth->setAttribute(PDO::SNOWFLAKE_ATTR_DESCRIBE_ONLY, false);
+    $sth->execute();
+    while($row = $sth->fetch(PDO::FETCH_NUM)) {
+        echo sprintf("C1: %s, C2: %s, C3: %s\n", $row[0], $row[1], $row[2]);
+    }
+
+    $dbh = null;
+?>
+===DONE===
+<?php exit(0); ?>
+--EXPECT--
+Connected to Snowflake
+describe only: true
+column count: 3
+name: C1, native_type: FIXED, scale: 2, precision: 10
+name: C2, native_type: TEXT, scale: 0, precision: 0
+name: C3, native_type: DATE, scale: 0, precision: 0
+row: false
+C1: 1.00, C2: test, C3: 2021-01-01
+===DONE===
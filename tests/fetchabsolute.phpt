@@ -0,0 +1,58 @@
+--TEST--
+pdo_snowflake - fetch with the absolute and relative row numbers
+--INI--
+pdo_snowflake.cacert=libsnowflakeclient/cacert.pem
+--FILE--
+<?php
+    include __DIR__ . "/common.php";
+
+    $dbh = new PDO($dsn, $user, $password);
+    $dbh->setAttribute( PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION );
+    echo "Connected to Snowflake\n";
+
+    $sth = $dbh->query("select seq8() + 1 from table(generator(rowcount=>50000)) order by 1");
+    $row = $sth->fetch(PDO::FETCH_NUM, PDO::FETCH_ORI_FIRST);
+    echo sprintf("first: %d\n", $row[0]);
+    $row = $sth->fetch(PDO::FETCH_NUM, PDO::FETCH_ORI_ABS, 30001);
+    echo sprintf("abs 30001: %d\n", $row[0]);
+    $row = $sth->fetch(PDO::FETCH_NUM, PDO::FETCH_ORI_REL, 0);
+    echo sprintf("rel 0: %d\n", $row[0]);
+    $row = $sth->fetch(PDO::FETCH_NUM);
+    echo sprintf("next: %d\n", $row[0]);
+    $row = $sth->fetch(PDO::FETCH_NUM, PDO::FETCH_ORI_REL, 10000);
+    echo sprintf("rel 10000: %d\n", $row[0]);
+
+    try {
+        $sth->fetch(PDO::FETCH_NUM, PDO::FETCH_ORI_ABS, 1);
+    } catch (PDOException $e) {
+        echo $e->getMessage() . "\n";
+    }
+    try {
+        $sth->fetch(PDO::FETCH_NUM, PDO::FETCH_ORI_PRIOR);
+    } catch (PDOException $e) {
+        echo $e->getMessage() . "\n";
+    }
+    try {
+        $sth->fetch(PDO::FETCH_NUM, PDO::FETCH_ORI_REL, PHP_INT_MAX);
+    } catch (PDOException $e) {
+        echo $e->getMessage() . "\n";
+    }
+
+    var_dump($sth->fetch(PDO::FETCH_NUM, PDO::FETCH_ORI_ABS, 50001));
+
+    $dbh = null;
+?>
+===DONE===
+<?php exit(0); ?>
+--EXPECT--
+Connected to Snowflake
+first: 1
+abs 30001: 30001
+rel 0: 30001
+next: 30002
+rel 10000: 40002
+SQLSTATE[HY106]: Fetch type out of range: The cursor is forward only
+SQLSTATE[HY106]: Fetch type out of range: The cursor is forward only
+SQLSTATE[HY106]: Fetch type out of range: The cursor is forward only
+bool(false)
+===DONE===
@@ -0,0 +1,88 @@
+--TEST--
+pdo_snowflake - defaults and overrides of the fetch attributes
+--INI--
+pdo_snowflake.cacert=libsnowflakeclient/cacert.pem
+--FILE--
+<?php
+    include __DIR__ . "/common.php";
+
+    $dbh = new PDO($dsn, $user, $password);
+    $dbh->setAttribute( PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION );
+    echo "Connected to Snowflake\n";
+
+    /* attribute => array(valid value, invalid value) */
+    $attributes = array(
+        "FETCH_TEMPORAL" => array(PDO::SNOWFLAKE_FETCH_TEMPORAL_EPOCH_SECONDS, 9),
+        "FETCH_NUMBER" => array(PDO::SNOWFLAKE_FETCH_NUMBER_NATIVE, 9),
+        "FETCH_VARIANT" => array(PDO::SNOWFLAKE_FETCH_VARIANT_ARRAY, 9),
+        "FETCH_BINARY" => array(PDO::SNOWFLAKE_FETCH_BINARY_RAW, 9),
+        "INTERN_STRINGS" => array(100, -1),
+    );
+    $overrides = array();
+    foreach ($attributes as $name => $values) {
+        $attr = constant("PDO::SNOWFLAKE_ATTR_$name");
+        echo sprintf("%s: %d", $name, $dbh->getAttribute($attr));
+        $dbh->setAttribute($attr, $values[0]);
+        echo sprintf(" -> %d\n", $dbh->getAttribute($attr));
+        try {
+            $dbh->setAttribute($attr, $values[1]);
+        } catch (PDOException $e) {
+            echo $e->getMessage() . "\n";
+        }
+        try {
+            $dbh->prepare("select 1", array($attr => $values[1]));
+        } catch (PDOException $e) {
+            echo $e->getMessage() . "\n";
+        }
+        $overrides[$attr] = 0;
+    }
+
+    $sql = "select '2021-01-01'::date, 42, parse_json('[1,2]'), to_binary('414243', 'HEX'), 'OPEN'";
+
+    /* the defaults of the connection */
+    $sth = $dbh->query($sql);
+    $row = $sth->fetch(PDO::FETCH_NUM);
+    foreach ($row as $i => $v) {
+        echo sprintf("C%d: %s %s\n", $i + 1, gettype($v), json_encode($v));
+    }
+
+    /* overridden by the driver options */
+    $sth = $dbh->prepare($sql, $overrides);
+    $sth->execute();
+    $row = $sth->fetch(PDO::FETCH_NUM);
+    foreach ($row as $i => $v) {
+        echo sprintf("C%d: %s\n", $i + 1, gettype($v));
+    }
+
+    $dbh = null;
+?>
+===DONE===
+<?php exit(0); ?>
+--EXPECT--
+Connected to Snowflake
+FETCH_TEMPORAL: 0 -> 1
+SQLSTATE[HY024]: Invalid attribute value: Invalid value of SNOWFLAKE_ATTR_FETCH_TEMPORAL
+SQLSTATE[HY024]: Invalid attribute value: Invalid value of SNOWFLAKE_ATTR_FETCH_TEMPORAL
+FETCH_NUMBER: 0 -> 1
+SQLSTATE[HY024]: Invalid attribute value: Invalid value of SNOWFLAKE_ATTR_FETCH_NUMBER
+SQLSTATE[HY024]: Invalid attribute value: Invalid value of SNOWFLAKE_ATTR_FETCH_NUMBER
+FETCH_VARIANT: 0 -> 1
+SQLSTATE[HY024]: Invalid attribute value: Invalid value of SNOWFLAKE_ATTR_FETCH_VARIANT
+SQLSTATE[HY024]: Invalid attribute value: Invalid value of SNOWFLAKE_ATTR_FETCH_VARIANT
+FETCH_BINARY: 0 -> 1
+SQLSTATE[HY024]: Invalid attribute value: Invalid value of SNOWFLAKE_ATTR_FETCH_BINARY
+SQLSTATE[HY024]: Invalid attribute value: Invalid value of SNOWFLAKE_ATTR_FETCH_BINARY
+INTERN_STRINGS: 0 -> 100
+SQLSTATE[HY024]: Invalid attribute value: Invalid value of SNOWFLAKE_ATTR_INTERN_STRINGS
+SQLSTATE[HY024]: Invalid attribute value: Invalid value of SNOWFLAKE_ATTR_INTERN_STRINGS
+C1: integer 1609459200
+C2: integer 42
+C3: array [1,2]
+C4: string "ABC"
+C5: string "OPEN"
+C1: string
+C2: string
+C3: string
+C4: string
+C5: string
+===DONE===
@@ -0,0 +1,54 @@
+--TEST--
+pdo_snowflake - fetch BINARY as raw bytes
+--INI--
+pdo_snowflake.cacert=libsnowflakeclient/cacert.pem
+--FILE--
+<?php
+    include __DIR__ . "/common.php";
+
+    $dbh = new PDO($dsn, $user, $password);
+    $dbh->setAttribute( PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION );
+    echo "Connected to Snowflake\n";
+
+    /* long enough to use the vectorized decoders */
+    $long = str_repeat("0123456789abcdefABCDEF", 10);
+    $sql = "select to_binary('1234ABCD00', 'HEX')," .
+        " to_binary('', 'HEX')," .
+        " to_binary('$long', 'HEX')," .
+        " null::binary";
+
+    $modes = array(
+        "HEX" => PDO::SNOWFLAKE_FETCH_BINARY_HEX,
+        "RAW" => PDO::SNOWFLAKE_FETCH_BINARY_RAW,
+    );
+    foreach ($modes as $name => $mode) {
+        echo "$name\n";
+        $sth = $dbh->prepare($sql, array(PDO::SNOWFLAKE_ATTR_FETCH_BINARY => $mode));
+        $sth->execute();
+        $row = $sth->fetch(PDO::FETCH_NUM);
+        echo sprintf("C1: %s %d %s\n", gettype($row[0]), strlen($row[0]),
+            $name == "RAW" ? bin2hex($row[0]) : $row[0]);
+        echo sprintf("C2: %s %s\n", gettype($row[1]), var_export($row[1], true));
+        echo sprintf("C3: %d %s\n", strlen($row[2]), md5($row[2]));
+        echo sprintf("C4: %s %s\n", gettype($row[3]), var_export($row[3], true));
+    }
+    echo sprintf("hex2bin: %s\n", md5(hex2bin($long)));
+
+    $dbh = null;
+?>
+===DONE===
+<?php exit(0); ?>
+--EXPECT--
+Connected to Snowflake
+HEX
+C1: string 10 1234ABCD00
+C2: string ''
+C3: 220 2351bda313209f7a478e31f1f854d3b7
+C4: NULL NULL
+RAW
+C1: string 5 1234abcd00
+C2: string ''
+C3: 110 d8ac962671cc680864b46eb35598bd6f
+C4: NULL NULL
+hex2bin: d8ac962671cc680864b46eb35598bd6f
+===DONE===
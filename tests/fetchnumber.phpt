@@ -0,0 +1,60 @@
+--TEST--
+pdo_snowflake - fetch NUMBER as integer or exact decimal string
+--INI--
+pdo_snowflake.cacert=libsnowflakeclient/cacert.pem
+--FILE--
+<?php
+    include __DIR__ . "/common.php";
+
+    $dbh = new PDO($dsn, $user, $password);
+    $dbh->setAttribute( PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION );
+    echo "Connected to Snowflake\n";
+
+    $sql = "select 123::number(38,0)," .
+        " -9223372036854775808::number(38,0)," .
+        " 9223372036854775808::number(38,0)," .
+        " 12345678901234567890123456789012345678::number(38,0)," .
+        " 1.50::number(10,2)," .
+        " -0.000000001::number(38,9)," .
+        " 1.5::float," .
+        " null::number(38,0)";
+
+    $modes = array(
+        "STRING" => PDO::SNOWFLAKE_FETCH_NUMBER_STRING,
+        "NATIVE" => PDO::SNOWFLAKE_FETCH_NUMBER_NATIVE,
+    );
+    foreach ($modes as $name => $mode) {
+        echo "$name\n";
+        $sth = $dbh->prepare($sql, array(PDO::SNOWFLAKE_ATTR_FETCH_NUMBER => $mode));
+        $sth->execute();
+        $row = $sth->fetch(PDO::FETCH_NUM);
+        foreach ($row as $i => $v) {
+            echo sprintf("C%d: %s %s\n", $i + 1, gettype($v), var_export($v, true));
+        }
+    }
+
+    $dbh = null;
+?>
+===DONE===
+<?php exit(0); ?>
+--EXPECT--
+Connected to Snowflake
+STRING
+C1: string '123'
+C2: string '-9223372036854775808'
+C3: string '9223372036854775808'
+C4: string '12345678901234567890123456789012345678'
+C5: string '1.50'
+C6: string '-0.000000001'
+C7: string '1.5'
+C8: NULL NULL
+NATIVE
+C1: integer 123
+C2: integer -9223372036854775807-1
+C3: string '9223372036854775808'
+C4: string '12345678901234567890123456789012345678'
+C5: string '1.50'
+C6: string '-0.000000001'
+C7: string '1.5'
+C8: NULL NULL
+===DONE===
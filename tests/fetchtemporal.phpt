@@ -0,0 +1,72 @@
+--TEST--
+pdo_snowflake - fetch DATE, TIME and TIMESTAMP as epoch or DateTimeImmutable
+--INI--
+pdo_snowflake.cacert=libsnowflakeclient/cacert.pem
+--FILE--
+<?php
+    include __DIR__ . "/common.php";
+
+    $dbh = new PDO($dsn, $user, $password);
+    $dbh->setAttribute( PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION );
+    echo "Connected to Snowflake\n";
+
+    $dbh->exec("alter session set timezone='Asia/Tokyo'");
+
+    $sql = "select '2021-01-01'::date," .
+        " '12:34:56.789'::time(3)," .
+        " '2021-01-01 12:34:56.789'::timestamp_ntz(3)," .
+        " '2021-01-01 12:34:56.789'::timestamp_ltz(3)," .
+        " '2021-01-01 12:34:56.789 +05:30'::timestamp_tz(3)," .
+        " '1969-12-31 23:59:59.5'::timestamp_ntz(1)," .
+        " null::timestamp_ntz";
+
+    $modes = array(
+        "EPOCH_SECONDS" => PDO::SNOWFLAKE_FETCH_TEMPORAL_EPOCH_SECONDS,
+        "EPOCH_NANOSECONDS" => PDO::SNOWFLAKE_FETCH_TEMPORAL_EPOCH_NANOSECONDS,
+        "DATETIME" => PDO::SNOWFLAKE_FETCH_TEMPORAL_DATETIME,
+    );
+    foreach ($modes as $name => $mode) {
+        echo "$name\n";
+        $sth = $dbh->prepare($sql, array(PDO::SNOWFLAKE_ATTR_FETCH_TEMPORAL => $mode));
+        $sth->execute();
+        $row = $sth->fetch(PDO::FETCH_NUM);
+        foreach ($row as $i => $v) {
+            if ($v instanceof DateTimeImmutable) {
+                echo sprintf("C%d: %s %s\n", $i + 1, get_class($v), $v->format("Y-m-d H:i:s.u P"));
+                continue;
+            }
+            echo sprintf("C%d: %s %s\n", $i + 1, gettype($v), var_export($v, true));
+        }
+    }
+
+    $dbh = null;
+?>
+===DONE===
+<?php exit(0); ?>
+--EXPECT--
+Connected to Snowflake
+EPOCH_SECONDS
+C1: integer 1609459200
+C2: integer 45296
+C3: integer 1609504496
+C4: integer 1609472096
+C5: integer 1609484696
+C6: integer -1
+C7: NULL NULL
+EPOCH_NANOSECONDS
+C1: integer 1609459200000000000
+C2: integer 45296789000000
+C3: integer 1609504496789000000
+C4: integer 1609472096789000000
+C5: integer 1609484696789000000
+C6: integer -500000000
+C7: NULL NULL
+DATETIME
+C1: DateTimeImmutable 2021-01-01 00:00:00.000000 +00:00
+C2: string '12:34:56.789'
+C3: DateTimeImmutable 2021-01-01 12:34:56.789000 +00:00
+C4: DateTimeImmutable 2021-01-01 12:34:56.789000 +09:00
+C5: DateTimeImmutable 2021-01-01 12:34:56.789000 +05:30
+C6: DateTimeImmutable 1969-12-31 23:59:59.500000 +00:00
+C7: NULL NULL
+===DONE===
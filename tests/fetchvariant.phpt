@@ -0,0 +1,51 @@
+--TEST--
+pdo_snowflake - fetch VARIANT, OBJECT and ARRAY as PHP values
+--INI--
+pdo_snowflake.cacert=libsnowflakeclient/cacert.pem
+--FILE--
+<?php
+    include __DIR__ . "/common.php";
+
+    $dbh = new PDO($dsn, $user, $password);
+    $dbh->setAttribute( PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION );
+    echo "Connected to Snowflake\n";
+
+    $sql = "select parse_json('{\"test1\":1,\"test2\":[\"a\",null]}')::object," .
+        " parse_json('[1,2,3]')::array," .
+        " parse_json('\"text\"')," .
+        " null::variant," .
+        " parse_json('12345678901234567890')";
+
+    $modes = array(
+        "ARRAY" => PDO::SNOWFLAKE_FETCH_VARIANT_ARRAY,
+        "OBJECT" => PDO::SNOWFLAKE_FETCH_VARIANT_OBJECT,
+    );
+    foreach ($modes as $name => $mode) {
+        echo "$name\n";
+        $sth = $dbh->prepare($sql, array(PDO::SNOWFLAKE_ATTR_FETCH_VARIANT => $mode));
+        $sth->execute();
+        $row = $sth->fetch(PDO::FETCH_NUM);
+        foreach ($row as $i => $v) {
+            echo sprintf("C%d: %s %s\n", $i + 1, gettype($v), json_encode($v));
+        }
+    }
+
+    $dbh = null;
+?>
+===DONE===
+<?php exit(0); ?>
+--EXPECT--
+Connected to Snowflake
+ARRAY
+C1: array {"test1":1,"test2":["a",null]}
+C2: array [1,2,3]
+C3: string "text"
+C4: NULL null
+C5: string "12345678901234567890"
+OBJECT
+C1: object {"test1":1,"test2":["a",null]}
+C2: array [1,2,3]
+C3: string "text"
+C4: NULL null
+C5: string "12345678901234567890"
+===DONE===
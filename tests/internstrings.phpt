@@ -0,0 +1,58 @@
+--TEST--
+pdo_snowflake - fetch TEXT with the shared strings of repeated values
+--INI--
+pdo_snowflake.cacert=libsnowflakeclient/cacert.pem
+--FILE--
+<?php
+    include __DIR__ . "/common.php";
+
+    $dbh = new PDO($dsn, $user, $password);
+    $dbh->setAttribute( PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION );
+    echo "Connected to Snowflake\n";
+
+    $sql = "select column2, column3 from values " .
+        "(1, 'OPEN', 'US'), (2, 'CLOSED', 'JP'), (3, 'OPEN', null), " .
+        "(4, 'PENDING', ''), (5, 'CLOSED', 'US'), (6, 'PENDING', 'JP') " .
+        "order by column1";
+
+    /* the cache holds two strings per column */
+    $sth = $dbh->prepare($sql, array(PDO::SNOWFLAKE_ATTR_INTERN_STRINGS => 2));
+    $sth->execute();
+    while ($row = $sth->fetch(PDO::FETCH_ASSOC)) {
+        echo sprintf("%s, %s\n", $row["COLUMN2"], var_export($row["COLUMN3"], true));
+    }
+
+    /* the same result without the cache */
+    $sth = $dbh->query($sql);
+    $rows = $sth->fetchAll(PDO::FETCH_NUM);
+    echo sprintf("rows: %d, last: %s, %s\n", count($rows), $rows[5][0], $rows[5][1]);
+
+    /* the shared strings aren't allocated for each row */
+    $sql = "select repeat('x', 100) from table(generator(rowcount => 10000))";
+    $usage = array();
+    foreach (array(0, 1) as $size) {
+        $sth = $dbh->prepare($sql, array(PDO::SNOWFLAKE_ATTR_INTERN_STRINGS => $size));
+        $sth->execute();
+        $before = memory_get_usage();
+        $rows = $sth->fetchAll(PDO::FETCH_COLUMN, 0);
+        $usage[$size] = memory_get_usage() - $before;
+        $sth = null;
+        $rows = null;
+    }
+    echo sprintf("shared: %s\n", $usage[1] * 2 < $usage[0] ? "yes" : "no");
+
+    $dbh = null;
+?>
+===DONE===
+<?php exit(0); ?>
+--EXPECT--
+Connected to Snowflake
+OPEN, 'US'
+CLOSED, 'JP'
+OPEN, NULL
+PENDING, ''
+CLOSED, 'US'
+PENDING, 'JP'
+rows: 6, last: PENDING, JP
+shared: yes
+===DONE===
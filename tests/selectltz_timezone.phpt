@@ -0,0 +1,55 @@
+--TEST--
+pdo_snowflake - select TIMESTAMP_LTZ in connections with different time zones
+--INI--
+pdo_snowflake.cacert=libsnowflakeclient/cacert.pem
+--FILE--
+<?php
+    include __DIR__ . "/common.php";
+
+    $ny = new PDO($dsn . ";timezone=America/New_York", $user, $password);
+    $ny->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+    $tokyo = new PDO($dsn . ";timezone=Asia/Tokyo", $user, $password);
+    $tokyo->setAttribute(PDO::ATTR_ERRMODE, PDO::ERRMODE_EXCEPTION);
+    echo "Connected to Snowflake\n";
+
+    // around the start and end of the daylight saving time in New York
+    $sql = "select column1, to_timestamp_ltz(column1)::timestamp_ltz(0), " .
+        "to_timestamp_tz('2021-03-14 03:00:00.5 -04:00')::timestamp_tz(3) " .
+        "from values (1615705199), (1615705200), (1636264799), (1636264800) " .
+        "order by 1";
+    $sth1 = $ny->query($sql);
+    $sth2 = $tokyo->query($sql);
+    while ($row = $sth1->fetch()) {
+        echo sprintf("New York: %s, %s, %s\n", $row[0], $row[1], $row[2]);
+        $row = $sth2->fetch();
+        echo sprintf("Tokyo: %s, %s, %s\n", $row[0], $row[1], $row[2]);
+    }
+
+    $sth1 = $ny->prepare($sql, [
+        PDO::SNOWFLAKE_ATTR_FETCH_TEMPORAL =>
+            PDO::SNOWFLAKE_FETCH_TEMPORAL_DATETIME]);
+    $sth1->execute();
+    while ($row = $sth1->fetch()) {
+        echo sprintf("New York: %s, %s\n", $row[0], $row[1]->format("c"));
+    }
+
+    $ny = null;
+    $tokyo = null;
+?>
+===DONE===
+<?php exit(0); ?>
+--EXPECT--
+Connected to Snowflake
+New York: 1615705199, 2021-03-14 01:59:59, 2021-03-14 03:00:00.500 -04:00
+Tokyo: 1615705199, 2021-03-14 15:59:59, 2021-03-14 03:00:00.500 -04:00
+New York: 1615705200, 2021-03-14 03:00:00, 2021-03-14 03:00:00.500 -04:00
+Tokyo: 1615705200, 2021-03-14 16:00:00, 2021-03-14 03:00:00.500 -04:00
+New York: 1636264799, 2021-11-07 01:59:59, 2021-03-14 03:00:00.500 -04:00
+Tokyo: 1636264799, 2021-11-07 14:59:59, 2021-03-14 03:00:00.500 -04:00
+New York: 1636264800, 2021-11-07 01:00:00, 2021-03-14 03:00:00.500 -04:00
+Tokyo: 1636264800, 2021-11-07 15:00:00, 2021-03-14 03:00:00.500 -04:00
+New York: 1615705199, 2021-03-14T01:59:59-05:00
+New York: 1615705200, 2021-03-14T03:00:00-04:00
+New York: 1636264799, 2021-11-07T01:59:59-04:00
+New York: 1636264800, 2021-11-07T01:00:00-05:00
+===DONE===